@@ -0,0 +1,284 @@
+#ifndef ELPP_DEFAULT_LOGGER
+#define ELPP_DEFAULT_LOGGER "Main"
+#endif
+#ifndef ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID
+#define ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID ELPP_DEFAULT_LOGGER
+#endif
+
+// Runs the device drivers against the simulated I²C bus and prints throughput and latency
+// usage: I2CSimBench.bin [clock in Hz] [iterations]
+
+#include <atomic>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../src/GPIOHelper/I2CBus.hpp"
+#include "../../src/GPIOHelper/I2CBusManager.hpp"
+#include "../../src/GPIOHelper/I2CDevice.hpp"
+#include "../../src/GPIOHelper/I2CPollPlanner.hpp"
+#include "../../src/GPIOHelper/I2CTransaction.hpp"
+#include "../../src/GPIOHelper/MCP23017.hpp"
+#include "../../src/GPIOHelper/MPU5060.hpp"
+#include "../../src/GPIOHelper/GpioPin.hpp"
+#include "../../src/GPIOHelper/SimI2CTransport.hpp"
+#include "../../src/GPIOHelper/SimMCP23017.hpp"
+#include "../../src/GPIOHelper/SimMPU6050.hpp"
+#include "../../src/GPIOHelper/SimSpiTransport.hpp"
+#include "../../src/GPIOHelper/SimTCA9548A.hpp"
+#include "../../src/GPIOHelper/SpiDevice.hpp"
+#include "../../src/GPIOHelper/TCA9548A.hpp"
+#include "../../src/common/easylogging/easylogging++.h"
+
+INITIALIZE_EASYLOGGINGPP
+
+static void Bench(const std::string& name, const unsigned int iterations, const std::function<void(unsigned int)>& step)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for(unsigned int index = 0; index < iterations; index++) {
+        step(index);
+    }
+    const auto took = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << iterations * 1000000.0 / took.count() << " ops/s"
+              << std::setw(10) << static_cast<double>(took.count()) / iterations << " us/op" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    START_EASYLOGGINGPP(argc, argv);
+
+    // the drivers log every access on debug, that would measure the logger
+    el::Configurations conf;
+    conf.setToDefault();
+    conf.set(el::Level::Debug, el::ConfigurationType::Enabled, "false");
+    conf.set(el::Level::Global, el::ConfigurationType::ToFile, "false");
+    el::Loggers::setDefaultConfigurations(conf, true);
+    el::Helpers::setThreadName("Main");
+
+    const unsigned int clockRate = argc > 1 ? static_cast<unsigned int>(std::stoul(argv[1])) : 400000;
+    const unsigned int iterations = argc > 2 ? static_cast<unsigned int>(std::stoul(argv[2])) : 2000;
+
+    auto transport = std::make_unique<SimI2CTransport>(clockRate);
+    auto simExpander = std::make_shared<SimMCP23017>();
+    auto simImu = std::make_shared<SimMPU6050>();
+    transport->AddDevice(0x20, simExpander);
+    transport->AddDevice(0x69, simImu);
+    simImu->SetMotion(100, -200, 16384, 5, -5, 1, 3000);
+
+    I2CBus bus(std::move(transport));
+    MCP23017 expander(&bus, 0x20);
+    MPU5060 imu(&bus, 0x69);
+
+    std::cout << "simulated bus " << clockRate << " Hz, " << iterations << " iterations" << std::endl;
+
+    if(!imu.InitDevice()) {
+        std::cout << "MPU6050 init failed" << std::endl;
+        return 1;
+    }
+
+    // bring-up after a brown-out, two batched transactions per chip
+    Bench("MPU5060 InitDevice", iterations / 10 + 1, [&](unsigned int) {
+        imu.InitDevice();
+    });
+    Bench("MCP23017 InitDevice", iterations / 10 + 1, [&](unsigned int) {
+        expander.InitDevice();
+    });
+
+    // warm restart of a chip that kept its configuration, one read and no write
+    I2CRegisterSnapshot expanderConfig;
+    expander.ReadConfig(expanderConfig);
+    Bench("MCP23017 RestoreConfig", iterations / 10 + 1, [&](unsigned int) {
+        expander.RestoreConfig(expanderConfig);
+    });
+
+    Bench("MCP23017 ConfigPin", 16, [&](unsigned int index) {
+        expander.ConfigPin(static_cast<unsigned char>(index), pin_direction::out);
+    });
+    Bench("MCP23017 SetPin", iterations, [&](unsigned int index) {
+        expander.SetPin(static_cast<unsigned char>(index % 16), index & 16 ? pin_value::on : pin_value::off);
+    });
+    Bench("MCP23017 WriteOutputs", iterations, [&](unsigned int index) {
+        expander.WriteOutputs(static_cast<unsigned short>(index));
+    });
+    Bench("MCP23017 GetPin", iterations, [&](unsigned int index) {
+        pin_value value;
+        expander.GetPin(static_cast<unsigned char>(index % 16), value);
+    });
+    // the 16 pins of one chip read within one millisecond cost one transfer
+    expander.SetInputCacheTtl(std::chrono::milliseconds(1));
+    Bench("MCP23017 GetPin (1ms cache)", iterations, [&](unsigned int index) {
+        pin_value value;
+        expander.GetPin(static_cast<unsigned char>(index % 16), value);
+    });
+    expander.SetInputCacheTtl(std::chrono::milliseconds(0));
+    Bench("MPU5060 GetMotion6", iterations, [&](unsigned int) {
+        double ax, ay, az, gx, gy, gz, temp;
+        imu.GetMotion6(&ax, &ay, &az, &gx, &gy, &gz, &temp);
+    });
+    Bench("MPU5060 GetTemp", iterations, [&](unsigned int) {
+        imu.GetTemp();
+    });
+
+    // logs the time of every read path the adapter supports
+    std::map<i2c_transfer_path, std::chrono::nanoseconds> pathTiming;
+    bus.BenchmarkReadPaths(0x69, 0x3B, 14, iterations / 10 + 1, pathTiming, false);
+
+    Bench("Transaction 2 devices", iterations, [&](unsigned int) {
+        unsigned char gpio[2];
+        unsigned char temp[2];
+        I2CTransaction transaction;
+        transaction.AddReadBytes(0x20, 0x12, 2, gpio);
+        transaction.AddReadBytes(0x69, 0x41, 2, temp);
+        bus.Execute(transaction);
+    });
+
+    Bench("Async reads (batch of 16)", iterations / 16, [&](unsigned int) {
+        unsigned char buffer[16][2];
+        std::vector<std::future<int>> pending;
+        for(auto index = 0; index < 16; index++) {
+            pending.push_back(bus.ReadBytesAsync(0x69, 0x41, 2, buffer[index]));
+        }
+        for(auto& result : pending) {
+            result.get();
+        }
+    });
+
+    bus.SetReadCoalescing(true);
+    Bench("Coalesced reads (batch 16)", iterations / 16, [&](unsigned int) {
+        unsigned char buffer[16][6];
+        std::vector<std::future<int>> pending;
+        for(auto index = 0; index < 16; index++) {
+            // accel, temp and gyro blocks of several pollers
+            pending.push_back(bus.ReadBytesAsync(0x69, static_cast<unsigned char>(0x3B + (index % 3) * 4), 6, buffer[index]));
+        }
+        for(auto& result : pending) {
+            result.get();
+        }
+    });
+    bus.SetReadCoalescing(false);
+    std::cout << "coalesced reads " << bus.GetCoalescedReads() << std::endl;
+
+    bus.SetWriteCombining(true);
+    Bench("Combined writes (4 regs)", iterations / 4, [&](unsigned int index) {
+        // sample rate divider and config block of the MPU6050
+        std::vector<std::future<int>> pending;
+        for(unsigned char reg = 0; reg < 4; reg++) {
+            const unsigned char value = static_cast<unsigned char>(reg == 2 || reg == 3 ? 0 : index);
+            pending.push_back(bus.WriteBytesAsync(0x69, static_cast<unsigned char>(0x19 + reg), 1, &value));
+        }
+        for(auto& result : pending) {
+            result.get();
+        }
+    });
+    bus.SetWriteCombining(false);
+    std::cout << "combined writes " << bus.GetCombinedWrites() << std::endl;
+
+    // four MPU6050 with the same address behind a TCA9548A
+    auto muxTransport = std::make_unique<SimI2CTransport>(clockRate);
+    auto simMux = std::make_shared<SimTCA9548A>();
+    muxTransport->AddDevice(0x70, simMux);
+    for(unsigned char channel = 0; channel < 4; channel++) {
+        simMux->AddDevice(channel, 0x68, std::make_shared<SimMPU6050>());
+    }
+    I2CBus muxBus(std::move(muxTransport));
+    TCA9548A mux(&muxBus, 0x70);
+    std::vector<std::unique_ptr<I2CDevice>> muxed;
+    for(unsigned char channel = 0; channel < 4; channel++) {
+        muxed.emplace_back(new I2CDevice(&mux, channel, 0x68));
+    }
+    Bench("Mux 4 channels round robin", iterations / 4, [&](unsigned int) {
+        unsigned char buffer[6];
+        for(auto& device : muxed) {
+            device->ReadBytes(0x3B, 6, buffer);
+        }
+    });
+    Bench("Mux 4x4 queued reads", iterations / 16, [&](unsigned int) {
+        unsigned char buffer[16][2];
+        std::vector<std::future<int>> pending;
+        for(auto index = 0; index < 16; index++) {
+            pending.push_back(muxed[index % 4]->ReadBytesAsync(static_cast<unsigned char>(0x3B + index / 4 * 2), 2, buffer[index]));
+        }
+        for(auto& result : pending) {
+            result.get();
+        }
+    });
+    std::cout << "mux selects " << muxBus.GetMuxSelects() << " skipped " << muxBus.GetMuxSelectsSkipped() << std::endl;
+
+    // planned polling of the mux sensors for one second
+    I2CPollPlanner planner(&muxBus);
+    std::atomic<unsigned int> samples{ 0 };
+    for(unsigned char channel = 0; channel < 4; channel++) {
+        const auto block = planner.AddBlock(muxed[channel].get(), 0x3B, 14, 100.0 * (channel + 1));
+        planner.Subscribe(block, [&samples](int result, const std::vector<unsigned char>&, std::chrono::steady_clock::time_point) {
+            if(result >= 0) samples++;
+        });
+    }
+    planner.Start();
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    planner.Stop();
+    std::cout << "planner load " << std::setprecision(2) << planner.GetLoad() << ", " << samples << " of 1000 samples, overruns "
+              << planner.GetOverruns(3) << std::endl;
+
+    // three buses with one MPU6050 and MCP23017 each, sequential versus one cycle over all buses
+    I2CBusManager manager;
+    for(const auto& name : {"bus1", "bus3", "bus4"}) {
+        auto managedTransport = std::make_unique<SimI2CTransport>(clockRate);
+        managedTransport->AddDevice(0x68, std::make_shared<SimMPU6050>());
+        managedTransport->AddDevice(0x21, std::make_shared<SimMCP23017>());
+        manager.AddBus(name, std::make_unique<I2CBus>(std::move(managedTransport)));
+    }
+    const i2c_job_delegate readMotion = [](I2CBus& job) {
+        unsigned char buffer[14];
+        return job.ReadBytes(0x68, 0x3B, 14, buffer);
+    };
+    Bench("3 buses sequential", iterations / 4, [&](unsigned int) {
+        for(const auto& name : manager.GetBusNames()) {
+            readMotion(*manager.GetBus(name));
+        }
+    });
+    Bench("3 buses RunOnAll", iterations / 4, [&](unsigned int) {
+        manager.RunOnAll(readMotion);
+    });
+
+    manager.AddIdentifyProbe("MCP23017", MCP23017::Identify);
+    manager.AddIdentifyProbe("MPU6050", MPU5060::Identify);
+    std::map<std::string, std::vector<I2CScanEntry>> inventory;
+    const auto scanStart = std::chrono::steady_clock::now();
+    manager.ScanAll(inventory);
+    const auto scanTook = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - scanStart);
+    std::cout << "scan of " << inventory.size() << " buses took " << scanTook.count() << " us" << std::endl;
+    for(const auto& entry : inventory) {
+        for(const auto& device : entry.second) {
+            std::cout << "  " << entry.first << " 0x" << std::hex << static_cast<int>(device.address) << std::dec << " "
+                      << (device.type.empty() ? "unknown" : device.type) << std::endl;
+        }
+    }
+
+    // the same 14 byte motion read on a 8 MHz spi chip select
+    auto spiTransport = std::make_unique<SimSpiTransport>(8000000);
+    spiTransport->SetDevice(std::make_shared<SimSpiDevice>());
+    SpiBus spiBus(std::move(spiTransport));
+    SpiDevice spiImu(&spiBus);
+    Bench("SPI read 14 bytes", iterations, [&](unsigned int) {
+        unsigned char buffer[14];
+        spiImu.ReadBytes(0x3B, 14, buffer);
+    });
+    Bench("SPI transaction 16 reads", iterations / 16, [&](unsigned int) {
+        unsigned char buffer[16][14];
+        SpiTransaction transaction;
+        for(auto index = 0; index < 16; index++) {
+            spiImu.AddReadBytes(transaction, 0x3B, 14, buffer[index]);
+        }
+        spiImu.Execute(transaction);
+    });
+
+    std::cout << bus.GetStatistics() << std::endl;
+    return 0;
+}
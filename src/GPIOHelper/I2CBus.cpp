@@ -33,37 +33,523 @@
 #endif
 
 #include "I2CBus.hpp"
-#include <fcntl.h> //Needed for I2C port
 #include <linux/i2c-dev.h> //Needed for I2C port
 #include <linux/i2c.h>
-#include <sys/ioctl.h> //Needed for I2C port
-#include <unistd.h> //Needed for I2C port
+#include <pthread.h>
+#include <sched.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <map>
 #include <iostream>
 #include "../common/easylogging/easylogging++.h"
 #include "../common/exception/ConfigErrorException.hpp"
+#include "../common/exception/NullPointerException.hpp"
+#include "I2CLockedBus.hpp"
+#include "I2CTransaction.hpp"
+#include "LinuxI2CTransport.hpp"
+#include <vector>
 
 /**
  * @brief Construct a new I2CBus::I2CBus object
  * 
  * @param device 
  */
-I2CBus::I2CBus(std::string device)
+I2CBus::I2CBus(std::string device) : I2CBus(std::make_unique<LinuxI2CTransport>(device))
 {
-    el::Loggers::getLogger(ELPP_DEFAULT_LOGGER);
-    _i2cBusHandle = open(device.c_str(), O_RDWR);
+}
 
-    if(_i2cBusHandle < 0) {
-        LOG(ERROR) << device << "Port open Failed";
-        std::string errmsg = device + std::string(" Port open Failed");
-        throw ConfigErrorException(errmsg);
+I2CBus::I2CBus(std::unique_ptr<I2CTransport> transport)
+{
+    el::Loggers::getLogger(ELPP_DEFAULT_LOGGER);
+    if(transport == nullptr) {
+        throw NullPointerException("transport");
+    }
+    _transport = std::move(transport);
+    _workerRun = false;
+    _workerSleeping = false;
+    _pending = 0;
+    _sequence = 0;
+    _deadlineMisses = 0;
+    _statisticsLogInterval = 0;
+    _statisticsNextLog = 0;
+    _workerCpu = -1;
+    _readCoalescing = false;
+    _readCoalescingWindow = 0;
+    _coalescedReads = 0;
+    _writeCombining = false;
+    _writeCombiningWindow = 0;
+    _combinedWrites = 0;
+    _activeRoute = -1;
+    _muxSelects = 0;
+    _muxSelectsSkipped = 0;
+    _routeBypass = 0;
+    _statistics.SetClockRate(_transport->ClockRate());
+    _functionality = _transport->Functionality();
+    _readPath = i2c_transfer_path::rdwr;
+    _writePath = i2c_transfer_path::rdwr;
+    for(const auto path : {i2c_transfer_path::rdwr, i2c_transfer_path::smbus_block, i2c_transfer_path::plain}) {
+        if(Supports(path, true)) {
+            _readPath = path;
+            break;
+        }
+    }
+    for(const auto path : {i2c_transfer_path::rdwr, i2c_transfer_path::smbus_block, i2c_transfer_path::plain}) {
+        if(Supports(path, false)) {
+            _writePath = path;
+            break;
+        }
+    }
+    if(!(_functionality & I2C_FUNC_I2C)) {
+        LOG(INFO) << "Adapter without I2C_RDWR, functionality 0x" << std::hex << _functionality;
     }
 }
 
 I2CBus::~I2CBus()
 {
-    if(_i2cBusHandle > 0) {
-        close(_i2cBusHandle);
+    StopWorker();
+}
+
+int I2CBus::Transfer(i2c_msg* messages, const unsigned int count, const I2CRoute& route, const bool logError)
+{
+    const auto waitStart = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(_mtx);
+    const auto transferStart = std::chrono::steady_clock::now();
+    const auto retVal = TransferLocked(messages, count, route);
+    const auto transferEnd = std::chrono::steady_clock::now();
+    lock.unlock();
+
+    _statistics.RecordLockWait(std::chrono::duration_cast<std::chrono::microseconds>(transferStart - waitStart));
+    _statistics.Record(messages, count, retVal, std::chrono::duration_cast<std::chrono::microseconds>(transferEnd - transferStart));
+    LogStatistics(transferEnd);
+
+    if(retVal < 0 && logError) {
+        _errors.Report(I2CStatusOf(retVal), static_cast<unsigned char>(messages[0].addr), messages[count - 1].flags & I2C_M_RD);
+    }
+
+    return retVal;
+}
+
+int I2CBus::ReadRegisters(const unsigned char deviceAddr,
+                          unsigned char& regAddr,
+                          unsigned char* value,
+                          const std::size_t length,
+                          const I2CRoute& route)
+{
+    // register write and reads of at most I2C_READ_CHUNK_MAX bytes in one ioctl, the chip keeps incrementing
+    const auto chunks = length == 0 ? 1 : (length + I2C_READ_CHUNK_MAX - 1) / I2C_READ_CHUNK_MAX;
+    if(chunks + 1 > I2C_RDWR_IOCTL_MAX_MSGS) return -9;
+
+    struct i2c_msg messages[I2C_RDWR_IOCTL_MAX_MSGS];
+    messages[0].addr = deviceAddr;
+    messages[0].flags = 0;
+    messages[0].len = 1;
+    messages[0].buf = &regAddr;
+    for(std::size_t chunk = 0; chunk < chunks; chunk++) {
+        const auto offset = chunk * I2C_READ_CHUNK_MAX;
+        messages[chunk + 1].addr = deviceAddr;
+        messages[chunk + 1].flags = I2C_M_RD;
+        messages[chunk + 1].len = static_cast<__u16>(std::min<std::size_t>(length - offset, I2C_READ_CHUNK_MAX));
+        messages[chunk + 1].buf = value + offset;
+    }
+
+    return Transfer(messages, static_cast<unsigned int>(chunks + 1), route);
+}
+
+int I2CBus::TransferLocked(i2c_msg* messages, const unsigned int count, const I2CRoute& route)
+{
+    const auto retVal = SelectRoute(route);
+    if(retVal < 0) return retVal;
+
+    // register read: pointer write then reads of the same device, register write: one message
+    auto registerRead = count >= 2 && !(messages[0].flags & I2C_M_RD) && messages[0].len == 1;
+    for(unsigned int index = 1; registerRead && index < count; index++) {
+        registerRead = (messages[index].flags & I2C_M_RD) && messages[index].addr == messages[0].addr;
+    }
+    if(registerRead) return TransferVia(messages, count, _readPath);
+    if(count == 1 && !(messages[0].flags & I2C_M_RD) && messages[0].len > 0) return TransferVia(messages, count, _writePath);
+    return _transport->Transfer(messages, count);
+}
+
+int I2CBus::TransferVia(i2c_msg* messages, const unsigned int count, const i2c_transfer_path path)
+{
+    const auto deviceAddr = static_cast<unsigned char>(messages[0].addr);
+    if(path == i2c_transfer_path::rdwr) return _transport->Transfer(messages, count);
+
+    if(count == 1) {
+        if(path == i2c_transfer_path::plain) {
+            const auto result = _transport->PlainWrite(deviceAddr, messages[0].buf, messages[0].len);
+            return result < 0 ? result : 1;
+        }
+        // an SMBus block write carries 1 - 32 data bytes, longer writes go in blocks with the register advanced
+        if(messages[0].len < 2) {
+            // a pointer only write has no SMBus block form
+            if(!Supports(i2c_transfer_path::plain, false)) return -EOPNOTSUPP;
+            const auto result = _transport->PlainWrite(deviceAddr, messages[0].buf, messages[0].len);
+            return result < 0 ? result : 1;
+        }
+        auto regAddr = messages[0].buf[0];
+        for(unsigned short offset = 1; offset < messages[0].len; offset += I2C_SMBUS_BLOCK_MAX) {
+            const auto length = static_cast<unsigned char>(std::min<unsigned short>(messages[0].len - offset, I2C_SMBUS_BLOCK_MAX));
+            const auto result = _transport->SmbusWriteBlock(deviceAddr, regAddr, messages[0].buf + offset, length);
+            if(result < 0) return result;
+            regAddr = static_cast<unsigned char>(regAddr + length);
+        }
+        return 1;
+    }
+
+    auto regAddr = messages[0].buf[0];
+    for(unsigned int index = 1; index < count; index++) {
+        auto& message = messages[index];
+        if(path == i2c_transfer_path::plain) {
+            const auto result = _transport->PlainRead(deviceAddr, regAddr, message.buf, message.len);
+            if(result < 0) return result;
+            regAddr = static_cast<unsigned char>(regAddr + message.len);
+            continue;
+        }
+        for(unsigned short offset = 0; offset < message.len; offset += I2C_SMBUS_BLOCK_MAX) {
+            const auto length = static_cast<unsigned char>(std::min<unsigned short>(message.len - offset, I2C_SMBUS_BLOCK_MAX));
+            const auto result = _transport->SmbusReadBlock(deviceAddr, regAddr, message.buf + offset, length);
+            if(result < 0) return result;
+            regAddr = static_cast<unsigned char>(regAddr + length);
+        }
+    }
+    return static_cast<int>(count);
+}
+
+bool I2CBus::Supports(const i2c_transfer_path path, const bool read) const
+{
+    switch(path) {
+        case i2c_transfer_path::rdwr:
+        case i2c_transfer_path::plain:
+            return _functionality & I2C_FUNC_I2C;
+        case i2c_transfer_path::smbus_block:
+            return _functionality & (read ? I2C_FUNC_SMBUS_READ_I2C_BLOCK : I2C_FUNC_SMBUS_WRITE_I2C_BLOCK);
+    }
+    return false;
+}
+
+unsigned long I2CBus::GetFunctionality() const
+{
+    return _functionality;
+}
+
+int I2CBus::SetTransferPaths(const i2c_transfer_path readPath, const i2c_transfer_path writePath)
+{
+    if(!Supports(readPath, true) || !Supports(writePath, false)) return -9;
+    _readPath = readPath;
+    _writePath = writePath;
+    return 0;
+}
+
+i2c_transfer_path I2CBus::GetReadPath() const
+{
+    return _readPath;
+}
+
+i2c_transfer_path I2CBus::GetWritePath() const
+{
+    return _writePath;
+}
+
+static const char* PathName(const i2c_transfer_path path)
+{
+    switch(path) {
+        case i2c_transfer_path::rdwr:
+            return "I2C_RDWR";
+        case i2c_transfer_path::smbus_block:
+            return "SMBus block";
+        case i2c_transfer_path::plain:
+            return "read/write";
+    }
+    return "unknown";
+}
+
+int I2CBus::BenchmarkReadPaths(const unsigned char deviceAddr,
+                               const unsigned char regAddr,
+                               const unsigned char length,
+                               const unsigned int iterations,
+                               std::map<i2c_transfer_path, std::chrono::nanoseconds>& timing,
+                               const bool select)
+{
+    if(length == 0 || iterations == 0) return -9;
+    if(UseWorker()) {
+        return SubmitJob([deviceAddr, regAddr, length, iterations, &timing, select](I2CBus& bus) {
+                   return bus.BenchmarkReadPaths(deviceAddr, regAddr, length, iterations, timing, select);
+               }).get();
+    }
+
+    timing.clear();
+    unsigned char value[256];
+    auto reg = regAddr;
+    struct i2c_msg messages[2];
+    for(const auto path : {i2c_transfer_path::rdwr, i2c_transfer_path::smbus_block, i2c_transfer_path::plain}) {
+        if(!Supports(path, true)) continue;
+
+        std::lock_guard<std::mutex> lock(_mtx);
+        const auto start = std::chrono::steady_clock::now();
+        auto result = 0;
+        for(unsigned int iteration = 0; iteration < iterations && result >= 0; iteration++) {
+            reg = regAddr;
+            messages[0] = {deviceAddr, 0, 1, &reg};
+            messages[1] = {deviceAddr, I2C_M_RD, length, value};
+            result = TransferVia(messages, 2, path);
+        }
+        if(result < 0) {
+            LOG(DEBUG) << "Benchmark " << PathName(path) << " failed " << result;
+            continue;
+        }
+        timing[path] = (std::chrono::steady_clock::now() - start) / iterations;
+    }
+    if(timing.empty()) return -1;
+
+    const auto fastest = std::min_element(timing.begin(), timing.end(), [](const auto& left, const auto& right) {
+                             return left.second < right.second;
+                         })->first;
+    for(const auto& entry : timing) {
+        LOG(INFO) << "Read of " << static_cast<int>(length) << " bytes over " << PathName(entry.first) << " "
+                  << entry.second.count() / 1000 << "us" << (entry.first == fastest ? " (fastest)" : "");
+    }
+    if(select) _readPath = fastest;
+    return static_cast<int>(timing.size());
+}
+
+int I2CBus::RunLocked(const i2c_locked_delegate& sequence, const I2CRequestOptions& options)
+{
+    if(sequence == nullptr) return -9;
+    if(UseWorker()) {
+        return SubmitJob([sequence, options](I2CBus& bus) { return bus.RunLocked(sequence, options); }, options).get();
+    }
+
+    const auto waitStart = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(_mtx);
+    _statistics.RecordLockWait(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - waitStart));
+    I2CLockedBus lockedBus(*this, options.route);
+    const auto result = sequence(lockedBus);
+    lock.unlock();
+
+    LogStatistics(std::chrono::steady_clock::now());
+    if(result < 0) {
+        // the failed transfer, else the sequence gave up on what the last transfer returned
+        const auto status = lockedBus._lastResult < 0 ? lockedBus._lastResult : result;
+        _errors.Report(I2CStatusOf(status), lockedBus._lastAddr, lockedBus._lastRead);
+    }
+    return result;
+}
+
+static int RouteKey(const I2CRoute& route)
+{
+    if(route.muxAddr == 0) return -1;
+    return route.muxAddr << 8 | route.channel;
+}
+
+int I2CBus::WriteMux(const unsigned char muxAddr, const unsigned char channels)
+{
+    auto value = channels;
+    i2c_msg message{};
+    message.addr = muxAddr;
+    message.flags = 0;
+    message.len = 1;
+    message.buf = &value;
+
+    const auto result = _transport->Transfer(&message, 1);
+    // after a failed write the state of the mux is unknown
+    _muxSelection[muxAddr] = result < 0 ? -1 : channels;
+    if(result < 0) _activeRoute = -1;
+    _muxSelects++;
+    return result;
+}
+
+int I2CBus::SelectRoute(const I2CRoute& route)
+{
+    if(route.muxAddr == 0) return 0;
+
+    const auto channels = static_cast<unsigned char>(1 << route.channel);
+    auto selection = _muxSelection.emplace(route.muxAddr, -1).first;
+    if(selection->second == channels) {
+        _muxSelectsSkipped++;
+        return 0;
+    }
+
+    // channels of other muxes off, equal addresses behind them would answer too
+    for(auto& mux : _muxSelection) {
+        if(mux.first == route.muxAddr || mux.second == 0) continue;
+        const auto result = WriteMux(mux.first, 0x00);
+        if(result < 0) return result;
+    }
+
+    // a failure is reported with the transfer, no logging under the lock
+    const auto result = WriteMux(route.muxAddr, channels);
+    if(result < 0) return result;
+    _activeRoute = RouteKey(route);
+    return 0;
+}
+
+int I2CBus::SetMuxChannels(const unsigned char muxAddr, const unsigned char channels)
+{
+    std::unique_lock<std::mutex> lock(_mtx);
+    _activeRoute = -1;
+    const auto result = WriteMux(muxAddr, channels);
+    lock.unlock();
+
+    if(result < 0) {
+        _errors.Report(I2CStatusOf(result), muxAddr, false);
+    }
+    return result;
+}
+
+void I2CBus::InvalidateMuxSelection()
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    for(auto& mux : _muxSelection) {
+        mux.second = -1;
+    }
+    _activeRoute = -1;
+}
+
+unsigned long I2CBus::GetMuxSelects() const
+{
+    return _muxSelects;
+}
+
+unsigned long I2CBus::GetMuxSelectsSkipped() const
+{
+    return _muxSelectsSkipped;
+}
+
+void I2CBus::LogStatistics(const std::chrono::steady_clock::time_point now)
+{
+    const auto interval = _statisticsLogInterval.load();
+    if(interval == 0) return;
+
+    const auto nowTicks = now.time_since_epoch().count();
+    auto next = _statisticsNextLog.load();
+    if(nowTicks < next) return;
+    // only one thread wins the log for this interval
+    const auto following = nowTicks + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::seconds(interval)).count();
+    if(!_statisticsNextLog.compare_exchange_strong(next, following)) return;
+    if(next == 0) return;
+
+    LOG(INFO) << "I2C statistics " << _statistics.Snapshot();
+}
+
+I2CBusStatistics I2CBus::GetStatistics()
+{
+    return _statistics.Snapshot();
+}
+
+I2CBusUtilisation I2CBus::GetUtilisation()
+{
+    return _statistics.Utilisation();
+}
+
+std::vector<unsigned char> I2CBus::GetSlowDevices(const std::chrono::microseconds threshold)
+{
+    return _statistics.SlowDevices(threshold);
+}
+
+void I2CBus::ResetStatistics()
+{
+    _statistics.Reset();
+}
+
+void I2CBus::SetStatisticsLogInterval(const unsigned int seconds)
+{
+    _statisticsLogInterval = seconds;
+    _statisticsNextLog = 0;
+}
+
+unsigned int I2CBus::GetClockRate() const
+{
+    return _transport->ClockRate();
+}
+
+int I2CBus::Probe(const unsigned char deviceAddr)
+{
+    if(deviceAddr > 0x7F) return -9;
+    if(UseWorker()) {
+        return SubmitJob([deviceAddr](I2CBus& bus) { return bus.Probe(deviceAddr); }).get();
     }
+
+    // like i2cdetect, a quick write can corrupt eeproms so read them
+    unsigned char value = 0x00;
+    i2c_msg message{};
+    message.addr = deviceAddr;
+    if((deviceAddr >= 0x30 && deviceAddr <= 0x37) || (deviceAddr >= 0x50 && deviceAddr <= 0x5F)) {
+        message.flags = I2C_M_RD;
+        message.len = 1;
+        message.buf = &value;
+    } else {
+        message.flags = 0;
+        message.len = 0;
+        message.buf = &value;
+    }
+
+    const auto result = Transfer(&message, 1, I2CRoute(), false);
+    return result < 0 ? result : 0;
+}
+
+int I2CBus::ReadCurrent(const unsigned char deviceAddr, const unsigned short length, unsigned char* value)
+{
+    if(deviceAddr > 0x7F || length == 0 || value == nullptr) return -9;
+    if(UseWorker()) {
+        return SubmitJob([deviceAddr, length, value](I2CBus& bus) { return bus.ReadCurrent(deviceAddr, length, value); }).get();
+    }
+
+    i2c_msg message{};
+    message.addr = deviceAddr;
+    message.flags = I2C_M_RD;
+    message.len = length;
+    message.buf = value;
+
+    const auto result = Transfer(&message, 1);
+    return result < 0 ? result : 0;
+}
+
+int I2CBus::Scan(std::vector<I2CScanEntry>& devices, const bool identify)
+{
+    if(UseWorker()) {
+        return SubmitJob([&devices, identify](I2CBus& bus) { return bus.Scan(devices, identify); }).get();
+    }
+
+    // the I2C_RDWR ioctl stops at the first nack without telling which message, so one probe per address
+    devices.clear();
+    for(unsigned char addr = I2C_SCAN_FIRST; addr <= I2C_SCAN_LAST; addr++) {
+        if(Probe(addr) < 0) continue;
+        I2CScanEntry entry;
+        entry.address = addr;
+        if(identify) entry.type = Identify(addr);
+        devices.push_back(entry);
+    }
+
+    LOG(DEBUG) << "Scan found " << devices.size() << " devices";
+    return static_cast<int>(devices.size());
+}
+
+void I2CBus::AddIdentifyProbe(const std::string& type, const i2c_identify_delegate& probe)
+{
+    std::lock_guard<std::mutex> lock(_identifyMtx);
+    _identifyProbes.emplace_back(type, probe);
+}
+
+std::string I2CBus::Identify(const unsigned char deviceAddr)
+{
+    std::vector<std::pair<std::string, i2c_identify_delegate>> probes;
+    {
+        std::lock_guard<std::mutex> lock(_identifyMtx);
+        probes = _identifyProbes;
+    }
+
+    for(const auto& probe : probes) {
+        if(probe.second(*this, deviceAddr)) return probe.first;
+    }
+    return std::string();
+}
+
+bool I2CBus::UseWorker() const
+{
+    // the worker itself (jobs) must not queue and wait for itself
+    return _workerRun && std::this_thread::get_id() != _workerId.load();
 }
 
 /** @brief Read multiple bits from an 8-bit device register.
@@ -82,7 +568,7 @@ int I2CBus::ReadBits(unsigned char deviceAddr,
 {
     unsigned char tempValue;
     auto result = ReadByte(deviceAddr, regAddr, tempValue);
-    if(tempValue < 0) {
+    if(result < 0) {
         value = 0x00;
         return result;
     }
@@ -95,121 +581,713 @@ int I2CBus::ReadBits(unsigned char deviceAddr,
     return result;
 }
 
-int I2CBus::ReadByte(const unsigned char deviceAddr, const unsigned char regAddr, unsigned char& value)
+int I2CBus::ReadByte(const unsigned char deviceAddr, const unsigned char regAddr, unsigned char& value, const I2CRequestOptions& options)
 {
-    if(_i2cBusHandle < 0) return -9;
+    return ReadBytes(deviceAddr, regAddr, 1, &value, options);
+}
 
-    _mtx.lock();
-    unsigned char outbuff;
-    struct i2c_msg messages[2];
+int I2CBus::ReadBytes(unsigned char deviceAddr,
+                      unsigned char regAddr,
+                      unsigned char length,
+                      unsigned char* value,
+                      const I2CRequestOptions& options)
+{
+    if(UseWorker()) return ReadBytesAsync(deviceAddr, regAddr, length, value, options).get();
 
-    outbuff = regAddr;
-    messages[0].addr = deviceAddr;
-    messages[0].flags = 0;
-    messages[0].len = sizeof(outbuff);
-    messages[0].buf = &outbuff;
+    return ReadRegisters(deviceAddr, regAddr, value, length, options.route);
+}
 
-    auto inbuff = &value;
-    messages[1].addr = deviceAddr;
-    messages[1].flags = I2C_M_RD;
-    messages[1].len = sizeof(*inbuff);
-    messages[1].buf = inbuff;
+int I2CBus::WriteBit(unsigned char deviceAddr, unsigned char regAddr, unsigned char bitNum, unsigned char value)
+{
+    const auto mask = static_cast<unsigned char>(1 << bitNum);
+    return RunLocked([deviceAddr, regAddr, mask, value](I2CLockedBus& bus) {
+        return bus.ModifyByte(deviceAddr, regAddr, mask, value != 0 ? mask : 0x00);
+    });
+}
+
+int I2CBus::WriteBits(unsigned char deviceAddr, unsigned char regAddr, unsigned char bitStart, unsigned char length, unsigned char value)
+{
+    const auto shift = bitStart - length + 1;
+    const auto mask = static_cast<unsigned char>(((1 << length) - 1) << shift);
+    return RunLocked([deviceAddr, regAddr, mask, shift, value](I2CLockedBus& bus) {
+        return bus.ModifyByte(deviceAddr, regAddr, mask, static_cast<unsigned char>(value << shift));
+    });
+}
+
+int I2CBus::WriteByte(const unsigned char deviceAddr,
+                      const unsigned char regAddr,
+                      const unsigned char value,
+                      const I2CRequestOptions& options)
+{
+    return WriteBytes(deviceAddr, regAddr, 1, &value, options);
+}
 
-    struct i2c_rdwr_ioctl_data packets {
-        .msgs = messages, .nmsgs = 2
-    };
+/** @brief Write consecutive registers in one transaction (register auto increment).
+ * @param deviceAddr I2C slave device address
+ * @param regAddr First register to write
+ * @param length Number of bytes to write
+ * @param value Bytes to write
+ * @param options Scheduling on the bus worker
+ * @return Status of write operation (0 < failed)
+ */
+int I2CBus::WriteBytes(unsigned char deviceAddr,
+                       unsigned char regAddr,
+                       unsigned char length,
+                       const unsigned char* value,
+                       const I2CRequestOptions& options)
+{
+    if(UseWorker()) return WriteBytesAsync(deviceAddr, regAddr, length, value, options).get();
 
+    unsigned char buff[256];
+    struct i2c_msg messages[1];
 
-    const auto retVal = ioctl(_i2cBusHandle, I2C_RDWR, &packets);
-    if(retVal < 0) LOG(ERROR) << "Read from I2C Device failed";
-    _mtx.unlock();
+    buff[0] = regAddr;
+    std::memcpy(&buff[1], value, length);
 
-    return retVal;
+    messages[0].addr = deviceAddr;
+    messages[0].flags = 0;
+    messages[0].len = static_cast<__u16>(length + 1);
+    messages[0].buf = buff;
+
+    return Transfer(messages, 1, options.route);
 }
 
-int I2CBus::ReadBytes(unsigned char deviceAddr, unsigned char regAddr, unsigned char length, unsigned char* value)
+i2c_status I2CBus::Read(const unsigned char deviceAddr,
+                        unsigned char regAddr,
+                        unsigned char* value,
+                        const std::size_t length,
+                        const I2CRequestOptions& options)
 {
-    if(_i2cBusHandle < 0) return -9;
+    if(value == nullptr || length > 0xFFFF) return i2c_status::invalid_argument;
+    if(UseWorker()) {
+        return I2CStatusOf(ReadBytesAsync(deviceAddr, regAddr, static_cast<unsigned short>(length), value, options).get());
+    }
+    return I2CStatusOf(ReadRegisters(deviceAddr, regAddr, value, length, options.route));
+}
 
-    _mtx.lock();
-    unsigned char outbuff;
-    struct i2c_msg messages[2];
+i2c_status I2CBus::Write(const unsigned char deviceAddr,
+                         const unsigned char regAddr,
+                         const unsigned char* value,
+                         const std::size_t length,
+                         const I2CRequestOptions& options)
+{
+    if(value == nullptr || length >= 0xFFFF) return i2c_status::invalid_argument;
+    if(UseWorker()) {
+        return I2CStatusOf(WriteBytesAsync(deviceAddr, regAddr, static_cast<unsigned short>(length), value, options).get());
+    }
 
-    outbuff = regAddr;
+    // the register has to lead the payload in the same message
+    unsigned char stackBuffer[64];
+    std::vector<unsigned char> heapBuffer;
+    auto buffer = stackBuffer;
+    if(length + 1 > sizeof(stackBuffer)) {
+        heapBuffer.resize(length + 1);
+        buffer = heapBuffer.data();
+    }
+    buffer[0] = regAddr;
+    std::memcpy(&buffer[1], value, length);
+
+    struct i2c_msg messages[1];
     messages[0].addr = deviceAddr;
     messages[0].flags = 0;
-    messages[0].len = sizeof(outbuff);
-    messages[0].buf = &outbuff;
+    messages[0].len = static_cast<__u16>(length + 1);
+    messages[0].buf = buffer;
+    return I2CStatusOf(Transfer(messages, 1, options.route));
+}
 
-    messages[1].addr = deviceAddr;
-    messages[1].flags = I2C_M_RD;
-    messages[1].len = length;
-    messages[1].buf = value;
+void I2CBus::SetErrorLogInterval(const std::chrono::milliseconds interval)
+{
+    _errors.SetInterval(interval);
+}
 
-    struct i2c_rdwr_ioctl_data packets {
-        .msgs = messages, .nmsgs = 2
-    };
+unsigned long I2CBus::GetErrorCount(const i2c_status status)
+{
+    return _errors.GetCount(status);
+}
 
+int I2CBus::Execute(I2CTransaction& transaction, const I2CRequestOptions& options)
+{
+    if(transaction.Empty()) return 0;
+    if(UseWorker()) {
+        return SubmitJob([&transaction, options](I2CBus& bus) { return bus.Execute(transaction, options); }, options).get();
+    }
 
-    const auto retVal = ioctl(_i2cBusHandle, I2C_RDWR, &packets);
-    if(retVal < 0) LOG(ERROR) << "Read from I2C Device failed";
-    _mtx.unlock();
+    std::vector<i2c_msg> messages;
+    std::vector<unsigned char> groups;
+    transaction.BuildMessages(messages, groups);
 
-    return retVal;
+    std::size_t first = 0;
+    std::size_t group = 0;
+    while(first < messages.size()) {
+        // fill the ioctl up to the kernel limit without splitting a register read
+        std::size_t count = 0;
+        while(group < groups.size() && count + groups[group] <= I2C_RDWR_IOCTL_MAX_MSGS) {
+            count += groups[group];
+            group++;
+        }
+
+        const auto retVal = Transfer(&messages[first], static_cast<unsigned int>(count), options.route);
+        if(retVal < 0) {
+            return retVal;
+        }
+        first += count;
+    }
+
+    return static_cast<int>(messages.size());
 }
 
-int I2CBus::WriteBit(unsigned char deviceAddr, unsigned char regAddr, unsigned char bitNum, unsigned char value)
+void I2CBus::StartWorker()
 {
-    unsigned char currentValue = 0x00;
-    auto result = ReadByte(deviceAddr, regAddr, currentValue);
-    if(result < 0) return result;
+    std::lock_guard<std::mutex> lock(_workerStartMtx);
+    StartWorkerLocked();
+}
 
-    currentValue = (value != 0) ? (currentValue | (1 << bitNum)) : (currentValue & ~(1 << bitNum));
+void I2CBus::StartWorkerLocked()
+{
+    if(_workerRun) return;
+    _workerRun = true;
+    _worker = std::thread(&I2CBus::WorkerLoop, this);
+    ApplyWorkerAffinity();
+}
 
-    return WriteByte(deviceAddr, regAddr, currentValue);
+void I2CBus::StopWorker()
+{
+    // hold the start lock until joined, a Submit meanwhile starts a fresh worker afterwards
+    std::lock_guard<std::mutex> lock(_workerStartMtx);
+    if(!_workerRun) return;
+    {
+        std::lock_guard<std::mutex> wakeLock(_wakeMtx);
+        _workerRun = false;
+    }
+    _wakeCv.notify_one();
+    if(_worker.joinable()) {
+        _worker.join();
+    }
 }
 
-int I2CBus::WriteBits(unsigned char deviceAddr, unsigned char regAddr, unsigned char bitStart, unsigned char length, unsigned char value)
+bool I2CBus::IsWorkerRunning() const
 {
-    unsigned char currentValue = 0x00;
-    auto result = ReadByte(deviceAddr, regAddr, currentValue);
-    if(result < 0) return result;
+    return _workerRun;
+}
 
-    uint8_t mask = ((1 << length) - 1) << (bitStart - length + 1);
-    value <<= (bitStart - length + 1); // shift data into correct position
-    value &= mask; // zero all non-important bits in data
-    currentValue &= ~(mask); // zero all important bits in existing byte
-    currentValue |= value; // combine data with existing byte
+int I2CBus::SetWorkerAffinity(const int cpu)
+{
+    if(cpu >= CPU_SETSIZE || cpu >= static_cast<int>(std::thread::hardware_concurrency())) {
+        LOG(ERROR) << "CPU " << cpu << " not available for I2C worker";
+        return -9;
+    }
+
+    std::lock_guard<std::mutex> lock(_workerStartMtx);
+    _workerCpu = cpu < 0 ? -1 : cpu;
+    if(!_workerRun) return 0;
+    return ApplyWorkerAffinity();
+}
 
-    return WriteByte(deviceAddr, regAddr, currentValue);
+int I2CBus::ApplyWorkerAffinity()
+{
+    const auto cpu = _workerCpu.load();
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    if(cpu < 0) {
+        for(unsigned int index = 0; index < std::thread::hardware_concurrency() && index < CPU_SETSIZE; index++) {
+            CPU_SET(index, &cpuSet);
+        }
+    } else {
+        CPU_SET(cpu, &cpuSet);
+    }
 
+    const auto result = pthread_setaffinity_np(_worker.native_handle(), sizeof(cpu_set_t), &cpuSet);
+    if(result != 0) {
+        LOG(ERROR) << "Set I2C worker affinity failed " << result;
+        return -result;
+    }
+    return 0;
 }
 
-int I2CBus::WriteByte(const unsigned char deviceAddr, const unsigned char regAddr, const unsigned char value)
+/**
+ * Ordering of the ready heap, true if a has to wait for b
+ */
+static bool RunsLater(const std::unique_ptr<I2CRequest>& a, const std::unique_ptr<I2CRequest>& b)
 {
-    if(_i2cBusHandle < 0) return -9;
+    if(a->priority != b->priority) return a->priority < b->priority;
 
-    _mtx.lock();
-    unsigned char buff[2];
-    struct i2c_msg messages[1];
+    const auto aHasDeadline = a->deadline != std::chrono::steady_clock::time_point();
+    const auto bHasDeadline = b->deadline != std::chrono::steady_clock::time_point();
+    if(aHasDeadline != bHasDeadline) return !aHasDeadline;
+    if(aHasDeadline && a->deadline != b->deadline) return a->deadline > b->deadline;
 
-    buff[0] = regAddr;
-    buff[1] = value;
+    return a->sequence > b->sequence;
+}
 
-    messages[0].addr = deviceAddr;
+void I2CBus::WorkerLoop()
+{
+    el::Helpers::setThreadName("I2CBus");
+    _workerId = std::this_thread::get_id();
+
+    while(true) {
+        TakeQueued();
+        if(_ready.empty()) {
+            if(_pending.load() > 0) {
+                // a producer is half way through Push
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(_wakeMtx);
+            if(!_workerRun) break;
+            _workerSleeping = true;
+            _wakeCv.wait(lock, [this] { return _pending.load() > 0 || !_workerRun; });
+            _workerSleeping = false;
+            continue;
+        }
+
+        auto request = TakeNext();
+        if(_readCoalescing && request->type == i2c_request_type::read && request->mergeable) {
+            ExecuteCoalesced(std::move(request));
+        } else if(_writeCombining && request->type == i2c_request_type::write && request->mergeable) {
+            ExecuteCombined(std::move(request));
+        } else {
+            ExecuteScheduled(*request);
+        }
+    }
+
+    // late requests are not executed anymore
+    while(_pending.load() > 0) {
+        auto request = _queue.Pop();
+        if(request == nullptr) {
+            std::this_thread::yield();
+            continue;
+        }
+        _pending--;
+        std::unique_ptr<I2CRequest> owner(request);
+        owner->Complete(-9);
+    }
+    _workerId = std::thread::id();
+}
+
+void I2CBus::TakeQueued()
+{
+    while(true) {
+        auto request = _queue.Pop();
+        if(request == nullptr) return;
+        _pending--;
+        _ready.emplace_back(request);
+        std::push_heap(_ready.begin(), _ready.end(), RunsLater);
+    }
+}
+
+bool I2CBus::IsLateDrop(I2CRequest& request)
+{
+    if(!request.dropWhenLate || request.deadline == std::chrono::steady_clock::time_point()) return false;
+
+    const auto now = std::chrono::steady_clock::now();
+    if(now <= request.deadline) return false;
+    ReportDeadlineMiss(request, now);
+    request.Complete(I2C_RESULT_DEADLINE_MISSED);
+    return true;
+}
+
+std::unique_ptr<I2CRequest> I2CBus::TakeNext()
+{
+    std::pop_heap(_ready.begin(), _ready.end(), RunsLater);
+    auto request = std::move(_ready.back());
+    _ready.pop_back();
+
+    // prefer requests that need no mux channel switch, inside the priority class and not past a deadline or job
+    const auto active = _activeRoute.load();
+    const auto needsSwitch = request->type != i2c_request_type::job && RouteKey(request->route) != -1 && RouteKey(request->route) != active;
+    const auto hasDeadline = request->deadline != std::chrono::steady_clock::time_point();
+    if(!needsSwitch || hasDeadline || _routeBypass >= I2C_MUX_GROUP_MAX) {
+        _routeBypass = 0;
+        return request;
+    }
+
+    auto barrier = std::numeric_limits<unsigned long long>::max();
+    for(const auto& other : _ready) {
+        if(other->type == i2c_request_type::job) barrier = std::min(barrier, other->sequence);
+    }
+    auto best = _ready.size();
+    for(size_t index = 0; index < _ready.size(); index++) {
+        const auto& other = _ready[index];
+        if(other->type == i2c_request_type::job || other->priority != request->priority || other->sequence > barrier) continue;
+        const auto key = RouteKey(other->route);
+        if(key != -1 && key != active) continue;
+        if(best == _ready.size() || other->sequence < _ready[best]->sequence) best = index;
+    }
+    if(best == _ready.size()) {
+        _routeBypass = 0;
+        return request;
+    }
+
+    _routeBypass++;
+    auto grouped = std::move(_ready[best]);
+    _ready[best] = std::move(request);
+    std::make_heap(_ready.begin(), _ready.end(), RunsLater);
+    return grouped;
+}
+
+void I2CBus::ExecuteScheduled(I2CRequest& request)
+{
+    if(IsLateDrop(request)) return;
+    const auto hasDeadline = request.deadline != std::chrono::steady_clock::time_point();
+
+    ProcessRequest(request);
+
+    if(hasDeadline) {
+        const auto now = std::chrono::steady_clock::now();
+        if(now > request.deadline) {
+            ReportDeadlineMiss(request, now);
+        }
+    }
+}
+
+void I2CBus::ExecuteCoalesced(std::unique_ptr<I2CRequest> first)
+{
+    if(IsLateDrop(*first)) return;
+    const auto window = _readCoalescingWindow.load();
+    if(window > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(window));
+        TakeQueued();
+    }
+
+    // a read queued after a write or job of the device must see its result
+    auto barrier = std::numeric_limits<unsigned long long>::max();
+    for(const auto& request : _ready) {
+        if(request->type == i2c_request_type::read) continue;
+        if(request->type == i2c_request_type::write && request->deviceAddr != first->deviceAddr) continue;
+        barrier = std::min(barrier, request->sequence);
+    }
+
+    std::vector<std::unique_ptr<I2CRequest>> group;
+    int start = first->regAddr;
+    int end = start + first->length;
+    group.push_back(std::move(first));
+
+    auto merged = true;
+    while(merged) {
+        merged = false;
+        for(size_t index = 0; index < _ready.size(); index++) {
+            auto& request = _ready[index];
+            if(request->type != i2c_request_type::read || !request->mergeable) continue;
+            if(request->deviceAddr != group.front()->deviceAddr || request->route != group.front()->route) continue;
+            if(request->sequence > barrier) continue;
+
+            const int requestStart = request->regAddr;
+            const int requestEnd = requestStart + request->length;
+            if(requestStart > end || requestEnd < start) continue;
+            const auto mergedStart = std::min(start, requestStart);
+            const auto mergedEnd = std::max(end, requestEnd);
+            if(mergedEnd - mergedStart > I2C_COALESCE_MAX_LENGTH) continue;
+
+            _ready[index].swap(_ready.back());
+            auto candidate = std::move(_ready.back());
+            _ready.pop_back();
+            index--;
+            merged = true;
+            if(IsLateDrop(*candidate)) continue;
+            start = mergedStart;
+            end = mergedEnd;
+            group.push_back(std::move(candidate));
+        }
+    }
+
+    std::make_heap(_ready.begin(), _ready.end(), RunsLater);
+    if(group.size() == 1) {
+        ExecuteScheduled(*group.front());
+        return;
+    }
+
+    std::vector<unsigned char> burst(static_cast<size_t>(end - start));
+    auto regAddr = static_cast<unsigned char>(start);
+    struct i2c_msg messages[2];
+    messages[0].addr = group.front()->deviceAddr;
     messages[0].flags = 0;
-    messages[0].len = sizeof(buff);
-    messages[0].buf = buff;
+    messages[0].len = 1;
+    messages[0].buf = &regAddr;
+    messages[1].addr = group.front()->deviceAddr;
+    messages[1].flags = I2C_M_RD;
+    messages[1].len = static_cast<__u16>(burst.size());
+    messages[1].buf = burst.data();
+    const auto result = Transfer(messages, 2, group.front()->route);
+    _coalescedReads += static_cast<unsigned long>(group.size() - 1);
 
-    struct i2c_rdwr_ioctl_data packets {
-        .msgs = messages, .nmsgs = 1
-    };
+    for(auto& request : group) {
+        auto target = request->buffer;
+        if(target == nullptr) {
+            request->data.resize(request->length);
+            target = request->data.data();
+        }
+        if(result >= 0) {
+            std::memcpy(target, &burst[static_cast<size_t>(request->regAddr - start)], request->length);
+        }
+        request->Complete(result);
 
+        if(request->deadline != std::chrono::steady_clock::time_point()) {
+            const auto now = std::chrono::steady_clock::now();
+            if(now > request->deadline) {
+                ReportDeadlineMiss(*request, now);
+            }
+        }
+    }
+}
 
-    const auto retVal = ioctl(_i2cBusHandle, I2C_RDWR, &packets);
-    if(retVal < 0) LOG(ERROR) << "Write to I2C Device failed";
+void I2CBus::ExecuteCombined(std::unique_ptr<I2CRequest> first)
+{
+    if(IsLateDrop(*first)) return;
+    const auto window = _writeCombiningWindow.load();
+    if(window > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(window));
+        TakeQueued();
+    }
 
-    _mtx.unlock();
+    // take the following requests of the device in submit order until one can not be merged,
+    // the device sees the writes in the same order as without combining
+    std::vector<size_t> following;
+    for(size_t index = 0; index < _ready.size(); index++) {
+        const auto& request = _ready[index];
+        if(request->sequence < first->sequence) continue;
+        if(request->type != i2c_request_type::job && (request->deviceAddr != first->deviceAddr || request->route != first->route)) continue;
+        following.push_back(index);
+    }
+    std::sort(following.begin(), following.end(), [this](const size_t a, const size_t b) {
+        return _ready[a]->sequence < _ready[b]->sequence;
+    });
 
-    return retVal;
+    std::vector<std::unique_ptr<I2CRequest>> group;
+    int start = first->regAddr;
+    int end = start + first->length;
+    group.push_back(std::move(first));
+
+    for(const auto index : following) {
+        auto& request = _ready[index];
+        if(request->type != i2c_request_type::write || !request->mergeable) break;
+
+        const int requestStart = request->regAddr;
+        const int requestEnd = requestStart + request->length;
+        if(requestStart > end || requestEnd < start) break;
+        const auto mergedStart = std::min(start, requestStart);
+        const auto mergedEnd = std::max(end, requestEnd);
+        if(mergedEnd - mergedStart > I2C_COALESCE_MAX_LENGTH) break;
+
+        auto candidate = std::move(request);
+        if(IsLateDrop(*candidate)) continue;
+        start = mergedStart;
+        end = mergedEnd;
+        group.push_back(std::move(candidate));
+    }
+    _ready.erase(std::remove(_ready.begin(), _ready.end(), nullptr), _ready.end());
+
+    std::make_heap(_ready.begin(), _ready.end(), RunsLater);
+    if(group.size() == 1) {
+        ExecuteScheduled(*group.front());
+        return;
+    }
+
+    // group is in submit order, overlapping registers get the last value
+    std::vector<unsigned char> burst(static_cast<size_t>(end - start + 1));
+    burst[0] = static_cast<unsigned char>(start);
+    for(const auto& request : group) {
+        std::memcpy(&burst[static_cast<size_t>(request->regAddr - start + 1)], request->data.data() + 1, request->length);
+    }
+
+    struct i2c_msg messages[1];
+    messages[0].addr = group.front()->deviceAddr;
+    messages[0].flags = 0;
+    messages[0].len = static_cast<__u16>(burst.size());
+    messages[0].buf = burst.data();
+    const auto result = Transfer(messages, 1, group.front()->route);
+    _combinedWrites += static_cast<unsigned long>(group.size() - 1);
+
+    for(auto& request : group) {
+        request->Complete(result);
+        if(request->deadline != std::chrono::steady_clock::time_point()) {
+            const auto now = std::chrono::steady_clock::now();
+            if(now > request->deadline) {
+                ReportDeadlineMiss(*request, now);
+            }
+        }
+    }
+}
+
+void I2CBus::SetWriteCombining(const bool enabled, const std::chrono::microseconds window)
+{
+    _writeCombiningWindow = window.count() > 0 ? window.count() : 0;
+    _writeCombining = enabled;
+}
+
+unsigned long I2CBus::GetCombinedWrites() const
+{
+    return _combinedWrites;
+}
+
+void I2CBus::SetReadCoalescing(const bool enabled, const std::chrono::microseconds window)
+{
+    _readCoalescingWindow = window.count() > 0 ? window.count() : 0;
+    _readCoalescing = enabled;
+}
+
+unsigned long I2CBus::GetCoalescedReads() const
+{
+    return _coalescedReads;
+}
+
+void I2CBus::ReportDeadlineMiss(const I2CRequest& request, const std::chrono::steady_clock::time_point now)
+{
+    _deadlineMisses++;
+    const auto late = std::chrono::duration_cast<std::chrono::microseconds>(now - request.deadline);
+    LOG(DEBUG) << "request for " << static_cast<int>(request.deviceAddr) << " missed deadline by " << late.count() << "us";
+
+    i2c_deadline_delegate callback;
+    {
+        std::lock_guard<std::mutex> lock(_deadlineMtx);
+        callback = _deadlineCallback;
+    }
+    if(callback != nullptr) {
+        callback(request.deviceAddr, late);
+    }
+}
+
+unsigned long I2CBus::GetDeadlineMisses() const
+{
+    return _deadlineMisses;
+}
+
+void I2CBus::SetDeadlineMissCallback(const i2c_deadline_delegate& callback)
+{
+    std::lock_guard<std::mutex> lock(_deadlineMtx);
+    _deadlineCallback = callback;
+}
+
+void I2CBus::ProcessRequest(I2CRequest& request)
+{
+    int result;
+    switch(request.type) {
+    case i2c_request_type::read: {
+        auto target = request.buffer;
+        if(target == nullptr) {
+            request.data.resize(request.length);
+            target = request.data.data();
+        }
+        result = ReadRegisters(request.deviceAddr, request.regAddr, target, request.length, request.route);
+        break;
+    }
+    case i2c_request_type::write: {
+        // data holds register and payload
+        struct i2c_msg messages[1];
+        messages[0].addr = request.deviceAddr;
+        messages[0].flags = 0;
+        messages[0].len = static_cast<__u16>(request.data.size());
+        messages[0].buf = request.data.data();
+        result = Transfer(messages, 1, request.route);
+        break;
+    }
+    case i2c_request_type::job:
+        result = request.job(*this);
+        break;
+    default:
+        result = -9;
+        break;
+    }
+    request.Complete(result);
+}
+
+std::future<int> I2CBus::Submit(std::unique_ptr<I2CRequest> request)
+{
+    std::future<int> future;
+    if(request->callback == nullptr) {
+        future = request->promise.get_future();
+    }
+    request->sequence = _sequence++;
+    {
+        // push under the start lock, a StopWorker can not drain and join between start and push
+        std::lock_guard<std::mutex> lock(_workerStartMtx);
+        StartWorkerLocked();
+        _queue.Push(request.release());
+        _pending++;
+    }
+    if(_workerSleeping.load()) {
+        std::lock_guard<std::mutex> lock(_wakeMtx);
+        _wakeCv.notify_one();
+    }
+    return future;
+}
+
+std::future<int> I2CBus::ReadBytesAsync(const unsigned char deviceAddr,
+                                        const unsigned char regAddr,
+                                        const unsigned short length,
+                                        unsigned char* value,
+                                        const I2CRequestOptions& options)
+{
+    auto request = std::make_unique<I2CRequest>();
+    request->type = i2c_request_type::read;
+    request->deviceAddr = deviceAddr;
+    request->regAddr = regAddr;
+    request->length = length;
+    request->buffer = value;
+    request->Apply(options);
+    return Submit(std::move(request));
+}
+
+void I2CBus::ReadBytesAsync(const unsigned char deviceAddr,
+                            const unsigned char regAddr,
+                            const unsigned short length,
+                            const i2c_completion_delegate& callback,
+                            const I2CRequestOptions& options)
+{
+    auto request = std::make_unique<I2CRequest>();
+    request->type = i2c_request_type::read;
+    request->deviceAddr = deviceAddr;
+    request->regAddr = regAddr;
+    request->length = length;
+    request->callback = callback;
+    request->Apply(options);
+    Submit(std::move(request));
+}
+
+static std::unique_ptr<I2CRequest> MakeWriteRequest(const unsigned char deviceAddr,
+                                                    const unsigned char regAddr,
+                                                    const unsigned short length,
+                                                    const unsigned char* value)
+{
+    auto request = std::make_unique<I2CRequest>();
+    request->type = i2c_request_type::write;
+    request->deviceAddr = deviceAddr;
+    request->regAddr = regAddr;
+    request->length = length;
+    request->data.reserve(length + 1);
+    request->data.push_back(regAddr);
+    request->data.insert(request->data.end(), value, value + length);
+    return request;
+}
+
+std::future<int> I2CBus::WriteBytesAsync(const unsigned char deviceAddr,
+                                         const unsigned char regAddr,
+                                         const unsigned short length,
+                                         const unsigned char* value,
+                                         const I2CRequestOptions& options)
+{
+    auto request = MakeWriteRequest(deviceAddr, regAddr, length, value);
+    request->Apply(options);
+    return Submit(std::move(request));
+}
+
+void I2CBus::WriteBytesAsync(const unsigned char deviceAddr,
+                             const unsigned char regAddr,
+                             const unsigned short length,
+                             const unsigned char* value,
+                             const i2c_completion_delegate& callback,
+                             const I2CRequestOptions& options)
+{
+    auto request = MakeWriteRequest(deviceAddr, regAddr, length, value);
+    request->callback = callback;
+    request->Apply(options);
+    Submit(std::move(request));
+}
+
+std::future<int> I2CBus::SubmitJob(const i2c_job_delegate& job, const I2CRequestOptions& options)
+{
+    auto request = std::make_unique<I2CRequest>();
+    request->type = i2c_request_type::job;
+    request->job = job;
+    request->Apply(options);
+    return Submit(std::move(request));
 }
@@ -23,17 +23,131 @@
  */
 
 #pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "I2CErrorReporter.hpp"
+#include "I2CLockedBus.hpp"
+#include "I2CRequest.hpp"
+#include "I2CScan.hpp"
+#include "I2CStatistics.hpp"
+#include "I2CTransport.hpp"
+#include "../common/utils/MpscQueue.hpp"
+
+/**
+ * Longest burst of merged reads or writes, see I2CBus::SetReadCoalescing
+ */
+#define I2C_COALESCE_MAX_LENGTH 32
+
+/**
+ * Longest read message, longer reads are split into several messages of one ioctl
+ */
+#define I2C_READ_CHUNK_MAX 255
+
+/**
+ * Maximum requests taken before the head of the queue to save mux channel switches
+ */
+#define I2C_MUX_GROUP_MAX 8
+
+class I2CTransaction;
+
+/**
+ * Sequence executed under one hold of the bus lock, see I2CBus::RunLocked
+ */
+typedef std::function<int(I2CLockedBus& bus)> i2c_locked_delegate;
+struct i2c_msg;
 
 /**
  * \ingroup SystemFunctions
  *
  * I2CBus
+ *
+ * Without worker every call does its transfer on the calling thread. After
+ * StartWorker (or the first asynchronous call) one thread per bus executes
+ * all requests, the synchronous functions then queue a request and wait for
+ * it. The worker takes the highest i2c_priority first, inside a class the
+ * earliest deadline, and otherwise keeps the submit order.
+ *
+ * Devices behind a TCA9548A carry an I2CRoute in their options. The bus
+ * writes the channel select only when the channel changes and the worker
+ * prefers requests of the selected channel inside a priority class.
  */
 class I2CBus
 {
-    int _i2cBusHandle{};
+    friend class I2CLockedBus;
+
+    std::unique_ptr<I2CTransport> _transport;
     std::mutex _mtx;
+    MpscQueue<I2CRequest> _queue;
+    std::thread _worker;
+    std::atomic<std::thread::id> _workerId;
+    std::atomic<bool> _workerRun;
+    std::atomic<bool> _workerSleeping;
+    std::atomic<unsigned int> _pending;
+    std::mutex _wakeMtx;
+    std::condition_variable _wakeCv;
+    std::mutex _workerStartMtx;
+    std::atomic<int> _workerCpu;
+    // owned by the worker, heap ordered by RunsLater
+    std::vector<std::unique_ptr<I2CRequest>> _ready;
+    std::atomic<unsigned long long> _sequence;
+    std::atomic<unsigned long> _deadlineMisses;
+    i2c_deadline_delegate _deadlineCallback;
+    std::mutex _deadlineMtx;
+    I2CStatisticsCollector _statistics;
+    I2CErrorReporter _errors;
+    std::atomic<unsigned int> _statisticsLogInterval;
+    std::atomic<std::chrono::steady_clock::rep> _statisticsNextLog;
+    std::vector<std::pair<std::string, i2c_identify_delegate>> _identifyProbes;
+    std::mutex _identifyMtx;
+    std::atomic<bool> _readCoalescing;
+    std::atomic<long long> _readCoalescingWindow;
+    std::atomic<unsigned long> _coalescedReads;
+    std::atomic<bool> _writeCombining;
+    std::atomic<long long> _writeCombiningWindow;
+    std::atomic<unsigned long> _combinedWrites;
+    // mux address to written channel bits, -1 unknown, guarded by _mtx
+    std::map<unsigned char, int> _muxSelection;
+    std::atomic<int> _activeRoute;
+    std::atomic<unsigned long> _muxSelects;
+    std::atomic<unsigned long> _muxSelectsSkipped;
+    // owned by the worker
+    unsigned int _routeBypass;
+    unsigned long _functionality;
+    std::atomic<i2c_transfer_path> _readPath;
+    std::atomic<i2c_transfer_path> _writePath;
+
+    int Transfer(i2c_msg* messages, unsigned int count, const I2CRoute& route = I2CRoute(), bool logError = true);
+    int ReadRegisters(unsigned char deviceAddr, unsigned char& regAddr, unsigned char* value, std::size_t length, const I2CRoute& route);
+    int TransferLocked(i2c_msg* messages, unsigned int count, const I2CRoute& route);
+    int TransferVia(i2c_msg* messages, unsigned int count, i2c_transfer_path path);
+    bool Supports(i2c_transfer_path path, bool read) const;
+    int SelectRoute(const I2CRoute& route);
+    int WriteMux(unsigned char muxAddr, unsigned char channels);
+    bool UseWorker() const;
+    void WorkerLoop();
+    void TakeQueued();
+    std::unique_ptr<I2CRequest> TakeNext();
+    void ExecuteScheduled(I2CRequest& request);
+    bool IsLateDrop(I2CRequest& request);
+    void ExecuteCoalesced(std::unique_ptr<I2CRequest> first);
+    void ExecuteCombined(std::unique_ptr<I2CRequest> first);
+    void ReportDeadlineMiss(const I2CRequest& request, std::chrono::steady_clock::time_point now);
+    void ProcessRequest(I2CRequest& request);
+    int ApplyWorkerAffinity();
+    // _workerStartMtx held
+    void StartWorkerLocked();
+    void LogStatistics(std::chrono::steady_clock::time_point now);
 
   public:
     /**
@@ -42,6 +156,12 @@ class I2CBus
      *    string to device tree sample /DEV/I2C-1
      */
     explicit I2CBus(std::string device);
+    /**
+     * Create new I2CBus on any transport
+     * @param transport
+     *    see I2CTransport, sample SimI2CTransport for tests
+     */
+    explicit I2CBus(std::unique_ptr<I2CTransport> transport);
     I2CBus(const I2CBus& orig) = delete;
     I2CBus(I2CBus&& other) = delete;
     I2CBus& operator=(const I2CBus& other) = delete;
@@ -53,8 +173,15 @@ class I2CBus
                  unsigned char bitStart,
                  unsigned char length,
                  unsigned char& value);
-    int ReadByte(unsigned char deviceAddr, unsigned char regAddr, unsigned char& value);
-    int ReadBytes(unsigned char deviceAddr, unsigned char regAddr, unsigned char length, unsigned char* value);
+    int ReadByte(unsigned char deviceAddr,
+                 unsigned char regAddr,
+                 unsigned char& value,
+                 const I2CRequestOptions& options = I2CRequestOptions());
+    int ReadBytes(unsigned char deviceAddr,
+                  unsigned char regAddr,
+                  unsigned char length,
+                  unsigned char* value,
+                  const I2CRequestOptions& options = I2CRequestOptions());
 
     int WriteBit(unsigned char deviceAddr, unsigned char regAddr, unsigned char bitNum, unsigned char value);
     int WriteBits(unsigned char deviceAddr,
@@ -62,5 +189,273 @@ class I2CBus
                  unsigned char bitStart,
                  unsigned char length,
                  unsigned char value);
-    int WriteByte(unsigned char deviceAddr, unsigned char regAddr, unsigned char value);
+    int WriteByte(unsigned char deviceAddr,
+                  unsigned char regAddr,
+                  unsigned char value,
+                  const I2CRequestOptions& options = I2CRequestOptions());
+    int WriteBytes(unsigned char deviceAddr,
+                   unsigned char regAddr,
+                   unsigned char length,
+                   const unsigned char* value,
+                   const I2CRequestOptions& options = I2CRequestOptions());
+
+    /**
+     * Read straight into caller memory, reads over I2C_READ_CHUNK_MAX bytes are split
+     * into several read messages of one transfer (the chip must auto increment)
+     * @return see i2c_status, errors are logged rate limited
+     */
+    i2c_status Read(unsigned char deviceAddr,
+                    unsigned char regAddr,
+                    unsigned char* value,
+                    std::size_t length,
+                    const I2CRequestOptions& options = I2CRequestOptions());
+    template <std::size_t N>
+    i2c_status Read(unsigned char deviceAddr,
+                    unsigned char regAddr,
+                    std::array<unsigned char, N>& value,
+                    const I2CRequestOptions& options = I2CRequestOptions())
+    {
+        return Read(deviceAddr, regAddr, value.data(), N, options);
+    }
+    /**
+     * Read a register block into a struct of the same layout, multi byte fields stay in chip byte order
+     */
+    template <typename T>
+    i2c_status ReadInto(unsigned char deviceAddr, unsigned char regAddr, T& value, const I2CRequestOptions& options = I2CRequestOptions())
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "ReadInto needs a trivially copyable type");
+        return Read(deviceAddr, regAddr, reinterpret_cast<unsigned char*>(&value), sizeof(T), options);
+    }
+    i2c_status Write(unsigned char deviceAddr,
+                     unsigned char regAddr,
+                     const unsigned char* value,
+                     std::size_t length,
+                     const I2CRequestOptions& options = I2CRequestOptions());
+    template <std::size_t N>
+    i2c_status Write(unsigned char deviceAddr,
+                     unsigned char regAddr,
+                     const std::array<unsigned char, N>& value,
+                     const I2CRequestOptions& options = I2CRequestOptions())
+    {
+        return Write(deviceAddr, regAddr, value.data(), N, options);
+    }
+    /**
+     * At most one error line per interval (default 1s), 0 logs every error
+     */
+    void SetErrorLogInterval(std::chrono::milliseconds interval);
+    unsigned long GetErrorCount(i2c_status status);
+
+    /**
+     * Run a read, compute, write sequence without any other access in between
+     * @param sequence
+     *    gets the I2CLockedBus, must only use it and not this bus
+     * @param options
+     *    the route is used for all accesses of the sequence
+     * @return result of the sequence
+     */
+    int RunLocked(const i2c_locked_delegate& sequence, const I2CRequestOptions& options = I2CRequestOptions());
+
+    /**
+     * Send all reads and writes of the transaction under one lock
+     * with one ioctl per I2C_RDWR_IOCTL_MAX_MSGS messages
+     * @param transaction
+     *    see I2CTransaction
+     * @return number of messages sent (0 < failed)
+     */
+    int Execute(I2CTransaction& transaction, const I2CRequestOptions& options = I2CRequestOptions());
+
+    /**
+     * Bus clock in Hz of the transport, for timing estimates see I2CTiming
+     */
+    unsigned int GetClockRate() const;
+
+    /**
+     * Adapter functionality bits (I2C_FUNC_*), queried once at open
+     */
+    unsigned long GetFunctionality() const;
+    /**
+     * Set the way register reads and writes go to the adapter, at open the bus takes
+     * I2C_RDWR if the adapter can, else the SMBus i2c block access, else plain read / write.
+     * The paths apply to every transfer that is one register read (pointer write, then reads
+     * of the same device) or one register write, also a transaction that holds only that.
+     * Other transfers (probes, transactions of several accesses) always use I2C_RDWR.
+     * @return 0 ok, -9 not supported by the adapter
+     */
+    int SetTransferPaths(i2c_transfer_path readPath, i2c_transfer_path writePath);
+    i2c_transfer_path GetReadPath() const;
+    i2c_transfer_path GetWritePath() const;
+    /**
+     * Measure a register read over every path the adapter supports
+     * @param timing
+     *    average time of one read per path
+     * @param select
+     *    use the fastest path for the reads from now on
+     * @return number of measured paths, < 0 failed
+     */
+    int BenchmarkReadPaths(unsigned char deviceAddr,
+                           unsigned char regAddr,
+                           unsigned char length,
+                           unsigned int iterations,
+                           std::map<i2c_transfer_path, std::chrono::nanoseconds>& timing,
+                           bool select = true);
+
+    /**
+     * Check whether a device answers on the address
+     * @return 0 answers, < 0 no device (-ENXIO) or bus error
+     */
+    int Probe(unsigned char deviceAddr);
+    /**
+     * Read from the current register pointer of the device without writing it first,
+     * safe on devices not identified yet
+     * @return 0 ok, < 0 error
+     */
+    int ReadCurrent(unsigned char deviceAddr, unsigned short length, unsigned char* value);
+    /**
+     * Probe all addresses I2C_SCAN_FIRST - I2C_SCAN_LAST
+     * @param devices
+     *    the answering devices
+     * @param identify
+     *    run the identify probes on every found device. A probe writes a register pointer only
+     *    where every chip at the address takes it as pointer (MPU5060::Identify at 0x68 / 0x69),
+     *    never where a chip without registers can take it as data (MCP23017::Identify reads only)
+     * @return number of found devices
+     */
+    int Scan(std::vector<I2CScanEntry>& devices, bool identify = true);
+    /**
+     * Register a probe for Scan, the first matching probe names the device
+     * @param type
+     *    sample "MCP23017"
+     */
+    void AddIdentifyProbe(const std::string& type, const i2c_identify_delegate& probe);
+    /**
+     * @return type of the first matching identify probe, empty if none
+     */
+    std::string Identify(unsigned char deviceAddr);
+
+    /**
+     * Start the bus worker thread, nothing happens if it is running
+     */
+    void StartWorker();
+    /**
+     * Stop the bus worker after the queued requests are done
+     */
+    void StopWorker();
+    bool IsWorkerRunning() const;
+    /**
+     * Pin the bus worker to one CPU, also used for a later started worker
+     * @param cpu
+     *    -1 all CPU (default)
+     * @return 0 ok, < 0 failed
+     */
+    int SetWorkerAffinity(int cpu);
+
+    /**
+     * Queue a register read
+     * @param value
+     *    caller memory, must stay valid until the future is ready
+     */
+    std::future<int> ReadBytesAsync(unsigned char deviceAddr,
+                                    unsigned char regAddr,
+                                    unsigned short length,
+                                    unsigned char* value,
+                                    const I2CRequestOptions& options = I2CRequestOptions());
+    /**
+     * Queue a register read, the bytes are handed to the callback
+     */
+    void ReadBytesAsync(unsigned char deviceAddr,
+                        unsigned char regAddr,
+                        unsigned short length,
+                        const i2c_completion_delegate& callback,
+                        const I2CRequestOptions& options = I2CRequestOptions());
+    /**
+     * Queue a register write, the bytes are copied
+     */
+    std::future<int> WriteBytesAsync(unsigned char deviceAddr,
+                                     unsigned char regAddr,
+                                     unsigned short length,
+                                     const unsigned char* value,
+                                     const I2CRequestOptions& options = I2CRequestOptions());
+    void WriteBytesAsync(unsigned char deviceAddr,
+                         unsigned char regAddr,
+                         unsigned short length,
+                         const unsigned char* value,
+                         const i2c_completion_delegate& callback,
+                         const I2CRequestOptions& options = I2CRequestOptions());
+    /**
+     * Run a function on the bus worker, see i2c_job_delegate
+     */
+    std::future<int> SubmitJob(const i2c_job_delegate& job, const I2CRequestOptions& options = I2CRequestOptions());
+    /**
+     * Queue a prepared request, the worker is started if needed
+     * @return future of the request, invalid when the request has a callback
+     */
+    std::future<int> Submit(std::unique_ptr<I2CRequest> request);
+
+    /**
+     * Let the worker merge queued reads of one device with adjacent or overlapping
+     * registers into one burst read, the device must support auto increment
+     * @param window
+     *    time the worker waits for more reads before it starts a read, 0 only merge queued reads
+     */
+    void SetReadCoalescing(bool enabled, std::chrono::microseconds window = std::chrono::microseconds(0));
+    /**
+     * Number of reads served by the burst of another read
+     */
+    unsigned long GetCoalescedReads() const;
+
+    /**
+     * Let the worker merge queued writes of one device to consecutive or overlapping
+     * registers into one auto increment write, the last submitted value wins
+     * @param window
+     *    time the worker waits for more writes, shared with SetReadCoalescing
+     */
+    void SetWriteCombining(bool enabled, std::chrono::microseconds window = std::chrono::microseconds(0));
+    /**
+     * Number of writes sent within the burst of another write
+     */
+    unsigned long GetCombinedWrites() const;
+
+    /**
+     * Write the channel register of a TCA9548A and remember it for the routing
+     * @param channels
+     *    bit 0 - 7 channel 0 - 7, 0 all off
+     */
+    int SetMuxChannels(unsigned char muxAddr, unsigned char channels);
+    /**
+     * Forget the selected mux channels, use after a mux reset
+     */
+    void InvalidateMuxSelection();
+    /**
+     * Number of channel select writes and of selects saved by the cache
+     */
+    unsigned long GetMuxSelects() const;
+    unsigned long GetMuxSelectsSkipped() const;
+
+    /**
+     * Number of requests finished after their deadline or dropped
+     */
+    unsigned long GetDeadlineMisses() const;
+    void SetDeadlineMissCallback(const i2c_deadline_delegate& callback);
+
+    /**
+     * Traffic, errors and latency per device address since start or ResetStatistics
+     */
+    I2CBusStatistics GetStatistics();
+    /**
+     * Estimated wire time and measured transfer time of the last second against the
+     * bus clock, busy minus wire is the driver overhead to plan poll rates with
+     */
+    I2CBusUtilisation GetUtilisation();
+    /**
+     * Addresses whose transfers take longer than the wire time plus the driver
+     * overhead plus threshold, sample clock stretching devices
+     */
+    std::vector<unsigned char> GetSlowDevices(std::chrono::microseconds threshold = std::chrono::microseconds(50));
+    void ResetStatistics();
+    /**
+     * Log the statistics with LOG(INFO) every interval, checked on transfer
+     * @param seconds
+     *    0 off (default)
+     */
+    void SetStatisticsLogInterval(unsigned int seconds);
 };
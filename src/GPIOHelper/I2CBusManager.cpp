@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   I2CBusManager.cpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#ifndef ELPP_DEFAULT_LOGGER
+#define ELPP_DEFAULT_LOGGER "I2CBusManager"
+#endif
+#ifndef ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID
+#define ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID ELPP_DEFAULT_LOGGER
+#endif
+
+#include "I2CBusManager.hpp"
+#include "../common/easylogging/easylogging++.h"
+#include "../common/exception/NullPointerException.hpp"
+
+I2CBusManager::I2CBusManager()
+{
+    el::Loggers::getLogger(ELPP_DEFAULT_LOGGER);
+}
+
+I2CBusManager::~I2CBusManager()
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    for(auto& entry : _buses) {
+        entry.second->StopWorker();
+    }
+}
+
+I2CBus* I2CBusManager::AddBus(const std::string& name, const std::string& device, const int cpu)
+{
+    return AddBus(name, std::make_unique<I2CBus>(device), cpu);
+}
+
+I2CBus* I2CBusManager::AddBus(const std::string& name, std::unique_ptr<I2CBus> bus, const int cpu)
+{
+    if(bus == nullptr) {
+        throw NullPointerException("bus");
+    }
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    if(_buses.find(name) != _buses.end()) {
+        LOG(ERROR) << "I2C bus " << name << " already added";
+        return nullptr;
+    }
+
+    if(bus->SetWorkerAffinity(cpu) < 0) {
+        LOG(ERROR) << "I2C bus " << name << " not added";
+        return nullptr;
+    }
+    for(const auto& probe : _identifyProbes) {
+        bus->AddIdentifyProbe(probe.first, probe.second);
+    }
+    bus->StartWorker();
+    auto result = bus.get();
+    _buses[name] = std::move(bus);
+    return result;
+}
+
+int I2CBusManager::RemoveBus(const std::string& name)
+{
+    std::unique_ptr<I2CBus> bus;
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        const auto entry = _buses.find(name);
+        if(entry == _buses.end()) return -9;
+        bus = std::move(entry->second);
+        _buses.erase(entry);
+    }
+    // destructor stops the worker after the queued requests
+    return 0;
+}
+
+I2CBus* I2CBusManager::GetBus(const std::string& name) const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    const auto entry = _buses.find(name);
+    if(entry == _buses.end()) return nullptr;
+    return entry->second.get();
+}
+
+std::vector<std::string> I2CBusManager::GetBusNames() const
+{
+    std::vector<std::string> names;
+    std::lock_guard<std::mutex> lock(_mtx);
+    for(const auto& entry : _buses) {
+        names.push_back(entry.first);
+    }
+    return names;
+}
+
+int I2CBusManager::RunCycle(const i2c_bus_cycle& cycle,
+                            std::map<std::string, int>* results,
+                            const I2CRequestOptions& options)
+{
+    std::vector<std::pair<std::string, std::future<int>>> pending;
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        for(const auto& job : cycle) {
+            if(_buses.find(job.first) == _buses.end()) {
+                LOG(ERROR) << "Unknown I2C bus " << job.first;
+                return -9;
+            }
+        }
+        for(const auto& job : cycle) {
+            pending.emplace_back(job.first, _buses[job.first]->SubmitJob(job.second, options));
+        }
+    }
+
+    auto retVal = 0;
+    for(auto& job : pending) {
+        const auto result = job.second.get();
+        if(results != nullptr) (*results)[job.first] = result;
+        if(result < 0 && retVal == 0) retVal = result;
+    }
+    return retVal;
+}
+
+int I2CBusManager::RunOnAll(const i2c_job_delegate& job, const I2CRequestOptions& options)
+{
+    i2c_bus_cycle cycle;
+    for(const auto& name : GetBusNames()) {
+        cycle[name] = job;
+    }
+    return RunCycle(cycle, nullptr, options);
+}
+
+void I2CBusManager::AddIdentifyProbe(const std::string& type, const i2c_identify_delegate& probe)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    _identifyProbes.emplace_back(type, probe);
+    for(auto& entry : _buses) {
+        entry.second->AddIdentifyProbe(type, probe);
+    }
+}
+
+int I2CBusManager::ScanAll(std::map<std::string, std::vector<I2CScanEntry>>& devices, const bool identify)
+{
+    devices.clear();
+    i2c_bus_cycle cycle;
+    for(const auto& name : GetBusNames()) {
+        // create all entries before the jobs run
+        auto& busDevices = devices[name];
+        cycle[name] = [&busDevices, identify](I2CBus& bus) { return bus.Scan(busDevices, identify); };
+    }
+
+    const auto result = RunCycle(cycle);
+    if(result < 0) return result;
+
+    auto count = 0;
+    for(const auto& entry : devices) {
+        count += static_cast<int>(entry.second.size());
+    }
+    return count;
+}
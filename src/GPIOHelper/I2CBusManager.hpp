@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   I2CBusManager.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "I2CBus.hpp"
+
+/**
+ * One job per bus name, see I2CBusManager::RunCycle
+ */
+typedef std::map<std::string, i2c_job_delegate> i2c_bus_cycle;
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * I2CBusManager owns several I2C buses, every bus has its own worker
+ * so the buses are busy at the same time. A poll cycle runs one job per bus
+ * in parallel and takes as long as the slowest bus.
+ */
+class I2CBusManager
+{
+    std::map<std::string, std::unique_ptr<I2CBus>> _buses;
+    std::vector<std::pair<std::string, i2c_identify_delegate>> _identifyProbes;
+    mutable std::mutex _mtx;
+
+  public:
+    I2CBusManager();
+    I2CBusManager(const I2CBusManager& orig) = delete;
+    I2CBusManager(I2CBusManager&& other) = delete;
+    I2CBusManager& operator=(const I2CBusManager& other) = delete;
+    I2CBusManager& operator=(I2CBusManager&& other) = delete;
+    virtual ~I2CBusManager();
+
+    /**
+     * Open and add a bus, the worker is started
+     * @param name
+     *    key of the bus, sample "sensors"
+     * @param device
+     *    string to device tree sample /DEV/I2C-1
+     * @param cpu
+     *    CPU for the bus worker, -1 all CPU
+     * @return the bus, nullptr if the name exists or the CPU is not available
+     */
+    I2CBus* AddBus(const std::string& name, const std::string& device, int cpu = -1);
+    /**
+     * Add a created bus, sample on a SimI2CTransport
+     */
+    I2CBus* AddBus(const std::string& name, std::unique_ptr<I2CBus> bus, int cpu = -1);
+    /**
+     * Stop and close the bus, all devices on it must be gone
+     * @return 0 ok, -9 unknown name
+     */
+    int RemoveBus(const std::string& name);
+    /**
+     * @return the bus or nullptr
+     */
+    I2CBus* GetBus(const std::string& name) const;
+    std::vector<std::string> GetBusNames() const;
+
+    /**
+     * Run the jobs on their bus workers in parallel and wait for all
+     * @param results
+     *    optional result of every job
+     * @return 0 ok, -9 unknown bus, otherwise the first failed job result
+     */
+    int RunCycle(const i2c_bus_cycle& cycle,
+                 std::map<std::string, int>* results = nullptr,
+                 const I2CRequestOptions& options = I2CRequestOptions());
+    /**
+     * Run the same job on every bus in parallel and wait for all
+     */
+    int RunOnAll(const i2c_job_delegate& job, const I2CRequestOptions& options = I2CRequestOptions());
+
+    /**
+     * Register an identify probe on all buses, also on buses added later
+     */
+    void AddIdentifyProbe(const std::string& type, const i2c_identify_delegate& probe);
+    /**
+     * Scan all buses in parallel, see I2CBus::Scan
+     * @param devices
+     *    found devices per bus name
+     * @return number of found devices, < 0 failed
+     */
+    int ScanAll(std::map<std::string, std::vector<I2CScanEntry>>& devices, bool identify = true);
+};
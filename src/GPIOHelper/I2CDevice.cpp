@@ -30,9 +30,12 @@
 #endif
 
 #include "I2CDevice.hpp"
+#include <algorithm>
+#include <memory>
 #include "../common/easylogging/easylogging++.h"
 #include "../common/exception/ConfigErrorException.hpp"
 #include "../common/exception/NullPointerException.hpp"
+#include "TCA9548A.hpp"
 
 I2CDevice::I2CDevice(I2CBus* bus, const unsigned char deviceAddr)
 {
@@ -42,6 +45,24 @@ I2CDevice::I2CDevice(I2CBus* bus, const unsigned char deviceAddr)
     }
     _bus = bus;
     _deviceAddr = deviceAddr;
+    _readCacheHits = 0;
+    _shadowUsed = false;
+    _readCacheUsed = false;
+}
+
+I2CDevice::I2CDevice(TCA9548A* mux, const unsigned char channel, const unsigned char deviceAddr)
+{
+    el::Loggers::getLogger(ELPP_DEFAULT_LOGGER);
+    if(mux == nullptr) {
+        throw NullPointerException("mux");
+    }
+    _bus = mux->GetBus();
+    _deviceAddr = deviceAddr;
+    _route = mux->GetRoute(channel);
+    _options.route = _route;
+    _readCacheHits = 0;
+    _shadowUsed = false;
+    _readCacheUsed = false;
 }
 
 I2CDevice::~I2CDevice()
@@ -57,30 +78,291 @@ I2CDevice::~I2CDevice()
  */
 int I2CDevice::ReadBits(unsigned char regAddr, unsigned char bitStart, unsigned char length, unsigned char& value)
 {
-    return _bus->ReadBits(_deviceAddr, regAddr, bitStart, length, value);
+    unsigned char tempValue = 0x00;
+    const auto result = ReadByte(regAddr, tempValue);
+    if(result < 0) {
+        value = 0x00;
+        return result;
+    }
+
+    const auto shift = bitStart - length + 1;
+    value = static_cast<unsigned char>((tempValue >> shift) & ((1 << length) - 1));
+    return result;
 }
 
 int I2CDevice::ReadByte(const unsigned char regAddr, unsigned char& value) const
 {
-    return _bus->ReadByte(_deviceAddr, regAddr, value);
+    if(ReadCached(regAddr, 1, &value)) return 0;
+    const auto result = _bus->ReadByte(_deviceAddr, regAddr, value, _options);
+    UpdateShadow(regAddr, 1, &value, result >= 0);
+    return result;
 }
 
 int I2CDevice::ReadBytes(unsigned char regAddr, unsigned char length, unsigned char* value)
 {
-    return _bus->ReadBytes(_deviceAddr, regAddr, length, value);
+    if(ReadCached(regAddr, length, value)) return 0;
+    const auto result = _bus->ReadBytes(_deviceAddr, regAddr, length, value, _options);
+    UpdateShadow(regAddr, length, value, result >= 0);
+    return result;
 }
 
 int I2CDevice::WriteBit(unsigned char regAddr, unsigned char bitNum, unsigned char value)
 {
-    return _bus->WriteBit(_deviceAddr, regAddr, bitNum, value);
+    const auto mask = static_cast<unsigned char>(1 << bitNum);
+    return ModifyByte(regAddr, mask, value != 0 ? mask : 0x00);
 }
 
 int I2CDevice::WriteBits(unsigned char regAddr, unsigned char bitStart, unsigned char length, unsigned char value)
 {
-    return _bus->WriteBits(_deviceAddr, regAddr, bitStart, length, value);
+    const auto shift = bitStart - length + 1;
+    const auto mask = static_cast<unsigned char>(((1 << length) - 1) << shift);
+    return ModifyByte(regAddr, mask, static_cast<unsigned char>(value << shift));
 }
 
 int I2CDevice::WriteByte(const unsigned char regAddr, const unsigned char value) const
 {
-    return _bus->WriteByte(_deviceAddr, regAddr, value);
+    return WriteBytes(regAddr, 1, &value);
+}
+
+int I2CDevice::WriteBytes(const unsigned char regAddr, const unsigned char length, const unsigned char* value) const
+{
+    // write and shadow under one bus lock like ModifyByte, else it can read the shadow from before the write
+    return _bus->RunLocked([this, regAddr, length, value](I2CLockedBus& bus) {
+        const auto result = bus.WriteBytes(_deviceAddr, regAddr, length, value);
+        UpdateShadow(regAddr, length, value, result >= 0, true);
+        return result;
+    }, _options);
+}
+
+i2c_status I2CDevice::Read(const unsigned char regAddr, unsigned char* value, const std::size_t length) const
+{
+    if(ReadCached(regAddr, length, value)) return i2c_status::ok;
+    return ReadUncached(regAddr, value, length);
+}
+
+i2c_status I2CDevice::ReadUncached(const unsigned char regAddr, unsigned char* value, const std::size_t length) const
+{
+    const auto status = _bus->Read(_deviceAddr, regAddr, value, length, _options);
+    UpdateShadow(regAddr, static_cast<unsigned short>(std::min<std::size_t>(length, 256)), value, status == i2c_status::ok);
+    return status;
+}
+
+std::future<int> I2CDevice::ReadBytesAsync(const unsigned char regAddr, const unsigned short length, unsigned char* value) const
+{
+    return _bus->ReadBytesAsync(_deviceAddr, regAddr, length, value, _options);
+}
+
+void I2CDevice::ReadBytesAsync(const unsigned char regAddr, const unsigned short length, const i2c_completion_delegate& callback) const
+{
+    _bus->ReadBytesAsync(_deviceAddr, regAddr, length, [this, regAddr, callback](int result, const std::vector<unsigned char>& data) {
+        UpdateShadow(regAddr, static_cast<unsigned short>(data.size()), data.data(), result >= 0);
+        if(callback != nullptr) callback(result, data);
+    }, _options);
+}
+
+std::future<int> I2CDevice::WriteBytesAsync(const unsigned char regAddr, const unsigned short length, const unsigned char* value) const
+{
+    // we do not know when the write lands, so the shadow has to read again after it
+    UpdateShadow(regAddr, length, value, false, true);
+    SetWritePending(regAddr, length, true);
+    auto promise = std::make_shared<std::promise<int>>();
+    auto future = promise->get_future();
+    _bus->WriteBytesAsync(_deviceAddr, regAddr, length, value, [this, regAddr, length, promise](int result, const std::vector<unsigned char>&) {
+        SetWritePending(regAddr, length, false);
+        promise->set_value(result);
+    }, _options);
+    return future;
+}
+
+std::future<int> I2CDevice::WriteByteAsync(const unsigned char regAddr, const unsigned char value) const
+{
+    return WriteBytesAsync(regAddr, 1, &value);
+}
+
+void I2CDevice::AddReadByte(I2CTransaction& transaction, const unsigned char regAddr, unsigned char& value) const
+{
+    transaction.AddReadByte(_deviceAddr, regAddr, value);
+}
+
+void I2CDevice::AddReadBytes(I2CTransaction& transaction, const unsigned char regAddr, const unsigned short length, unsigned char* value) const
+{
+    transaction.AddReadBytes(_deviceAddr, regAddr, length, value);
+}
+
+void I2CDevice::AddWriteByte(I2CTransaction& transaction, const unsigned char regAddr, const unsigned char value) const
+{
+    transaction.AddWriteByte(_deviceAddr, regAddr, value);
+    UpdateShadow(regAddr, 1, &value, false, true, true);
+}
+
+void I2CDevice::AddWriteBytes(I2CTransaction& transaction,
+                              const unsigned char regAddr,
+                              const unsigned short length,
+                              const unsigned char* value) const
+{
+    transaction.AddWriteBytes(_deviceAddr, regAddr, length, value);
+    UpdateShadow(regAddr, length, value, false, true, true);
+}
+
+void I2CDevice::AddReadRegisters(I2CTransaction& transaction, const std::bitset<256>& registers, unsigned char* image) const
+{
+    for(unsigned short reg = 0; reg < 256; reg++) {
+        if(!registers[reg]) continue;
+        auto end = reg;
+        while(end + 1 < 256 && registers[end + 1]) end++;
+        transaction.AddReadBytes(_deviceAddr, static_cast<unsigned char>(reg), static_cast<unsigned short>(end - reg + 1), image + reg);
+        reg = end;
+    }
+}
+
+int I2CDevice::Execute(I2CTransaction& transaction) const
+{
+    const auto result = _bus->Execute(transaction, _options);
+    std::lock_guard<std::mutex> lock(_shadowMtx);
+    _shadowValid &= ~(_writeQueued | (_readCached & ~_shadowCacheable));
+    _writeQueued.reset();
+    return result;
+}
+
+void I2CDevice::SetRegisterCacheable(const unsigned char regAddr, const unsigned short count, const bool cacheable)
+{
+    std::lock_guard<std::mutex> lock(_shadowMtx);
+    for(unsigned short reg = regAddr; reg < regAddr + count && reg < 256; reg++) {
+        _shadowCacheable[reg] = cacheable;
+        _shadowValid[reg] = false;
+    }
+    _shadowUsed = _shadowCacheable.any();
+}
+
+void I2CDevice::SetReadCacheTtl(const unsigned char regAddr, const unsigned short count, const std::chrono::steady_clock::duration ttl)
+{
+    std::lock_guard<std::mutex> lock(_shadowMtx);
+    for(unsigned short reg = regAddr; reg < regAddr + count && reg < 256; reg++) {
+        _readCached[reg] = ttl > std::chrono::steady_clock::duration::zero();
+        _readCacheTtl[reg] = ttl;
+        if(!_shadowCacheable[reg]) _shadowValid[reg] = false;
+    }
+    _readCacheUsed = _readCached.any();
+}
+
+void I2CDevice::InvalidateReadCache()
+{
+    std::lock_guard<std::mutex> lock(_shadowMtx);
+    _shadowValid &= ~(_readCached & ~_shadowCacheable);
+}
+
+unsigned long I2CDevice::GetReadCacheHits() const
+{
+    return _readCacheHits;
+}
+
+void I2CDevice::SetRequestOptions(const I2CRequestOptions& options)
+{
+    _options = options;
+    _options.route = _route;
+}
+
+const I2CRequestOptions& I2CDevice::GetRequestOptions() const
+{
+    return _options;
+}
+
+void I2CDevice::InvalidateShadow()
+{
+    std::lock_guard<std::mutex> lock(_shadowMtx);
+    _shadowValid.reset();
+}
+
+void I2CDevice::UpdateShadow(const unsigned char regAddr,
+                             const unsigned short length,
+                             const unsigned char* value,
+                             const bool ok,
+                             const bool write,
+                             const bool queued) const
+{
+    if(!_shadowUsed && !_readCacheUsed) return;
+
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(_shadowMtx);
+    // a write can change any status register of the device
+    if(write) _shadowValid &= ~(_readCached & ~_shadowCacheable);
+    for(unsigned short index = 0; index < length && regAddr + index < 256; index++) {
+        const auto reg = regAddr + index;
+        if(queued) _writeQueued[reg] = true;
+        if(!_shadowCacheable[reg] && (write || !_readCached[reg])) continue;
+        if(!write && _writeQueued[reg]) continue;
+        if(_writePending[reg] > 0) {
+            // a read or write before the async write lands is overwritten by it
+            _shadowValid[reg] = false;
+            continue;
+        }
+        // on error we do not know what the device holds now
+        _shadowValid[reg] = ok;
+        if(ok) {
+            _shadow[reg] = value[index];
+            _shadowTime[reg] = now;
+        }
+    }
+}
+
+void I2CDevice::SetWritePending(const unsigned char regAddr, const unsigned short length, const bool pending) const
+{
+    std::lock_guard<std::mutex> lock(_shadowMtx);
+    for(unsigned short reg = regAddr; reg < regAddr + length && reg < 256; reg++) {
+        if(pending) {
+            _writePending[reg]++;
+        } else if(_writePending[reg] > 0) {
+            _writePending[reg]--;
+        }
+        _shadowValid[reg] = false;
+    }
+}
+
+bool I2CDevice::GetShadow(const unsigned char regAddr, unsigned char& value) const
+{
+    std::lock_guard<std::mutex> lock(_shadowMtx);
+    if(!_shadowCacheable[regAddr] || !_shadowValid[regAddr]) return false;
+    value = _shadow[regAddr];
+    return true;
+}
+
+bool I2CDevice::ReadCached(const unsigned char regAddr, const std::size_t length, unsigned char* value) const
+{
+    if(!_readCacheUsed || regAddr + length > 256) return false;
+
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(_shadowMtx);
+    for(std::size_t index = 0; index < length; index++) {
+        const auto reg = regAddr + index;
+        if(!_readCached[reg] || !_shadowValid[reg] || now - _shadowTime[reg] > _readCacheTtl[reg]) return false;
+    }
+    std::copy(_shadow.begin() + regAddr, _shadow.begin() + regAddr + static_cast<long>(length), value);
+    _readCacheHits++;
+    return true;
+}
+
+/** Change only the masked bits of a register, without bus read when the shadow is valid
+ * @return Status of write operation (0 < failed)
+ */
+int I2CDevice::ModifyByte(const unsigned char regAddr, const unsigned char mask, const unsigned char value)
+{
+    // shadow, read and write under one bus lock, a second writer of the register can not get in between
+    return _bus->RunLocked([this, regAddr, mask, value](I2CLockedBus& bus) {
+        unsigned char currentValue = 0x00;
+        if(!GetShadow(regAddr, currentValue)) {
+            const auto result = bus.ReadByte(_deviceAddr, regAddr, currentValue);
+            UpdateShadow(regAddr, 1, &currentValue, result >= 0);
+            if(result < 0) return result;
+        }
+
+        currentValue = static_cast<unsigned char>((currentValue & ~mask) | (value & mask));
+        const auto result = bus.WriteByte(_deviceAddr, regAddr, currentValue);
+        UpdateShadow(regAddr, 1, &currentValue, result >= 0, true);
+        return result;
+    }, _options);
+}
+
+int I2CDevice::RunLocked(const i2c_locked_delegate& sequence) const
+{
+    return _bus->RunLocked(sequence, _options);
 }
@@ -23,17 +23,61 @@
  */
 
 #pragma once
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <mutex>
 #include "I2CBus.hpp"
+#include "I2CTransaction.hpp"
+
+class TCA9548A;
 
 /**
  * \ingroup SystemFunctions
  *
  * I2CDevice
+ *
+ * Registers the device never changes on its own (configuration) can be
+ * declared cacheable. Their last written or read value is kept as shadow and
+ * WriteBit / WriteBits use it instead of reading the register first.
+ *
+ * Status registers several users poll can get a read cache with a time to
+ * live, synchronous reads inside the time are served from memory. Any write to
+ * the device drops these values, it may change the status.
  */
 class I2CDevice
 {
     unsigned char _deviceAddr;
     I2CBus* _bus;
+    I2CRequestOptions _options;
+    I2CRoute _route;
+    std::bitset<256> _shadowCacheable;
+    mutable std::bitset<256> _shadowValid;
+    mutable std::array<unsigned char, 256> _shadow{};
+    mutable std::mutex _shadowMtx;
+    std::bitset<256> _readCached;
+    std::array<std::chrono::steady_clock::duration, 256> _readCacheTtl{};
+    mutable std::array<std::chrono::steady_clock::time_point, 256> _shadowTime{};
+    mutable std::atomic<unsigned long> _readCacheHits;
+    // any bit in _shadowCacheable / _readCached, checked without the lock on every access
+    std::atomic<bool> _shadowUsed;
+    std::atomic<bool> _readCacheUsed;
+    // written by a queued transaction, reads before Execute do not refresh the shadow
+    mutable std::bitset<256> _writeQueued;
+    // async writes not landed yet, the shadow of these registers stays invalid
+    mutable std::array<unsigned short, 256> _writePending{};
+
+    void UpdateShadow(unsigned char regAddr,
+                      unsigned short length,
+                      const unsigned char* value,
+                      bool ok,
+                      bool write = false,
+                      bool queued = false) const;
+    bool GetShadow(unsigned char regAddr, unsigned char& value) const;
+    void SetWritePending(unsigned char regAddr, unsigned short length, bool pending) const;
+    bool ReadCached(unsigned char regAddr, std::size_t length, unsigned char* value) const;
+    int ModifyByte(unsigned char regAddr, unsigned char mask, unsigned char value);
 
   public:
     /**
@@ -44,6 +88,16 @@ class I2CDevice
      *    the device adresse 0 - 127
      */
     I2CDevice(I2CBus* bus, unsigned char deviceAddr);
+    /**
+     * Create new I2CDevice behind a multiplexer
+     * @param mux
+     *    see TCA9548A
+     * @param channel
+     *    the mux channel 0 - 7
+     * @param deviceAddr
+     *    the device adresse 0 - 127
+     */
+    I2CDevice(TCA9548A* mux, unsigned char channel, unsigned char deviceAddr);
     I2CDevice(const I2CDevice& orig) = delete;
     I2CDevice(I2CDevice&& other) = delete;
     I2CDevice& operator=(const I2CDevice& other) = delete;
@@ -63,4 +117,92 @@ class I2CDevice
                  unsigned char length,
                  unsigned char value);
     int WriteByte(unsigned char regAddr, unsigned char value) const;
+    int WriteBytes(unsigned char regAddr, unsigned char length, const unsigned char* value) const;
+
+    /**
+     * Read straight into caller memory, see I2CBus::Read
+     */
+    i2c_status Read(unsigned char regAddr, unsigned char* value, std::size_t length) const;
+    /**
+     * Read from the device also when the read cache is fresh, the cache takes the new values
+     */
+    i2c_status ReadUncached(unsigned char regAddr, unsigned char* value, std::size_t length) const;
+    template <std::size_t N>
+    i2c_status Read(unsigned char regAddr, std::array<unsigned char, N>& value) const
+    {
+        return Read(regAddr, value.data(), N);
+    }
+    template <typename T>
+    i2c_status ReadInto(unsigned char regAddr, T& value) const
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "ReadInto needs a trivially copyable type");
+        return Read(regAddr, reinterpret_cast<unsigned char*>(&value), sizeof(T));
+    }
+
+    /**
+     * Asynchronous access through the bus worker, see I2CBus
+     */
+    std::future<int> ReadBytesAsync(unsigned char regAddr, unsigned short length, unsigned char* value) const;
+    void ReadBytesAsync(unsigned char regAddr, unsigned short length, const i2c_completion_delegate& callback) const;
+    std::future<int> WriteBytesAsync(unsigned char regAddr, unsigned short length, const unsigned char* value) const;
+    /**
+     * Queue a single register write, with I2CBus::SetWriteCombining consecutive
+     * registers go out in one transaction
+     */
+    std::future<int> WriteByteAsync(unsigned char regAddr, unsigned char value) const;
+
+    /**
+     * Queue register access of this device in a transaction, see I2CBus::Execute
+     * A queued write drops the shadow and read cache values it can change until
+     * Execute of this device sent it
+     */
+    void AddReadByte(I2CTransaction& transaction, unsigned char regAddr, unsigned char& value) const;
+    void AddReadBytes(I2CTransaction& transaction, unsigned char regAddr, unsigned short length, unsigned char* value) const;
+    void AddWriteByte(I2CTransaction& transaction, unsigned char regAddr, unsigned char value) const;
+    void AddWriteBytes(I2CTransaction& transaction, unsigned char regAddr, unsigned short length, const unsigned char* value) const;
+    /**
+     * Queue reads of the marked registers, neighbours in one read
+     * @param image
+     *    256 bytes, register n goes to image[n]
+     */
+    void AddReadRegisters(I2CTransaction& transaction, const std::bitset<256>& registers, unsigned char* image) const;
+    int Execute(I2CTransaction& transaction) const;
+    /**
+     * Run a read, compute, write sequence under one bus lock, see I2CBus::RunLocked
+     */
+    int RunLocked(const i2c_locked_delegate& sequence) const;
+
+    /**
+     * Keep a shadow of the registers (write through, dropped on error)
+     * @param regAddr
+     *    first register
+     * @param count
+     *    number of registers
+     * @param cacheable
+     *    false removes the registers from the shadow
+     */
+    void SetRegisterCacheable(unsigned char regAddr, unsigned short count = 1, bool cacheable = true);
+    /**
+     * Serve synchronous reads of the registers from memory for ttl after the last read
+     * @param ttl
+     *    0 removes the read cache, duration::max() until a write or InvalidateReadCache
+     *    (for registers the device never changes itself)
+     */
+    void SetReadCacheTtl(unsigned char regAddr, unsigned short count, std::chrono::steady_clock::duration ttl);
+    /**
+     * Drop the cached values, sample after a write of another bus user
+     */
+    void InvalidateReadCache();
+    unsigned long GetReadCacheHits() const;
+    /**
+     * Scheduling of all requests of this device on the bus worker
+     * @param options
+     *    see I2CRequestOptions, the route of the device is kept
+     */
+    void SetRequestOptions(const I2CRequestOptions& options);
+    const I2CRequestOptions& GetRequestOptions() const;
+    /**
+     * Forget all shadow values, use after a device reset or power loss
+     */
+    void InvalidateShadow();
 };
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   I2CErrorReporter.cpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#ifndef ELPP_DEFAULT_LOGGER
+#define ELPP_DEFAULT_LOGGER "I2CBus"
+#endif
+#ifndef ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID
+#define ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID ELPP_DEFAULT_LOGGER
+#endif
+
+#include "I2CErrorReporter.hpp"
+#include "../common/easylogging/easylogging++.h"
+
+I2CErrorReporter::I2CErrorReporter(const std::chrono::milliseconds interval) : _interval(interval), _suppressed(0)
+{
+    el::Loggers::getLogger(ELPP_DEFAULT_LOGGER);
+}
+
+void I2CErrorReporter::Report(const i2c_status status, const unsigned char deviceAddr, const bool read)
+{
+    unsigned long suppressed;
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        _counts[static_cast<size_t>(status)]++;
+        const auto now = std::chrono::steady_clock::now();
+        if(_lastLog != std::chrono::steady_clock::time_point() && now - _lastLog < _interval) {
+            _suppressed++;
+            return;
+        }
+        _lastLog = now;
+        suppressed = _suppressed;
+        _suppressed = 0;
+    }
+
+    LOG(ERROR) << (read ? "Read from" : "Write to") << " I2C Device " << static_cast<int>(deviceAddr) << " failed: " << status
+               << (suppressed > 0 ? " (" + std::to_string(suppressed) + " errors not logged)" : "");
+}
+
+void I2CErrorReporter::SetInterval(const std::chrono::milliseconds interval)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    _interval = interval;
+}
+
+unsigned long I2CErrorReporter::GetCount(const i2c_status status)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _counts[static_cast<size_t>(status)];
+}
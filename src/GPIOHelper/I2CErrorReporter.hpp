@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   I2CErrorReporter.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include "I2CStatus.hpp"
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * I2CErrorReporter counts failed accesses and logs at most one line per interval,
+ * the line tells how many errors were not logged since. Call it outside the bus lock.
+ */
+class I2CErrorReporter
+{
+    std::array<unsigned long, I2C_STATUS_COUNT> _counts{};
+    std::chrono::steady_clock::time_point _lastLog;
+    std::chrono::milliseconds _interval;
+    unsigned long _suppressed;
+    std::mutex _mtx;
+
+  public:
+    explicit I2CErrorReporter(std::chrono::milliseconds interval = std::chrono::milliseconds(1000));
+    I2CErrorReporter(const I2CErrorReporter& orig) = delete;
+    I2CErrorReporter& operator=(const I2CErrorReporter& other) = delete;
+
+    /**
+     * @param read
+     *    the failed transfer ended with a read
+     */
+    void Report(i2c_status status, unsigned char deviceAddr, bool read);
+    /**
+     * @param interval
+     *    0 logs every error
+     */
+    void SetInterval(std::chrono::milliseconds interval);
+    unsigned long GetCount(i2c_status status);
+};
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * File:   I2CInitSequence.cpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#ifndef ELPP_DEFAULT_LOGGER
+#define ELPP_DEFAULT_LOGGER "I2CDevice"
+#endif
+#ifndef ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID
+#define ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID ELPP_DEFAULT_LOGGER
+#endif
+
+#include "I2CInitSequence.hpp"
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cerrno>
+#include <thread>
+#include "../common/easylogging/easylogging++.h"
+#include "I2CDevice.hpp"
+
+void I2CInitSequence::AddWrite(const unsigned char regAddr, const unsigned char value)
+{
+    AddWrite(regAddr, 0xFF, value);
+}
+
+void I2CInitSequence::AddWrite(const unsigned char regAddr, const unsigned char mask, const unsigned char value)
+{
+    _steps.push_back(Step{i2c_init_step::write, regAddr, mask, value, std::chrono::milliseconds(0)});
+}
+
+void I2CInitSequence::AddVerify(const unsigned char regAddr, const unsigned char mask, const unsigned char expected)
+{
+    _steps.push_back(Step{i2c_init_step::verify, regAddr, mask, expected, std::chrono::milliseconds(0)});
+}
+
+void I2CInitSequence::AddDelay(const std::chrono::milliseconds delay)
+{
+    _steps.push_back(Step{i2c_init_step::delay, 0x00, 0x00, 0x00, delay});
+}
+
+static bool CheckVerify(const unsigned char regAddr, const unsigned char mask, const unsigned char expected, const unsigned char value)
+{
+    if((value & mask) == (expected & mask)) return true;
+    LOG(ERROR) << "init verify register 0x" << std::hex << static_cast<int>(regAddr) << " is 0x" << static_cast<int>(value)
+               << " expected 0x" << static_cast<int>(expected & mask) << " mask 0x" << static_cast<int>(mask);
+    return false;
+}
+
+int I2CInitSequence::RunBatch(I2CDevice& device, const std::vector<Step>::const_iterator begin, const std::vector<Step>::const_iterator end) const
+{
+    // registers needed before the writes: masked writes of unknown registers and the first verifies
+    std::bitset<256> readFirst;
+    std::bitset<256> known;
+    std::bitset<256> readAfter;
+    auto written = false;
+    for(auto step = begin; step != end; ++step) {
+        if(step->type == i2c_init_step::verify) {
+            if(written) {
+                readAfter[step->regAddr] = true;
+            } else {
+                readFirst[step->regAddr] = true;
+            }
+            continue;
+        }
+        if(step->mask != 0xFF && !known[step->regAddr]) readFirst[step->regAddr] = true;
+        known[step->regAddr] = true;
+        written = true;
+    }
+
+    auto transactions = 0;
+    std::array<unsigned char, 256> image{};
+    if(readFirst.any()) {
+        I2CTransaction transaction;
+        device.AddReadRegisters(transaction, readFirst, image.data());
+        const auto result = device.Execute(transaction);
+        if(result < 0) return result;
+        transactions++;
+    }
+
+    // values of all writes in order, following registers go into one write
+    std::vector<std::pair<unsigned char, std::vector<unsigned char>>> writes;
+    written = false;
+    for(auto step = begin; step != end; ++step) {
+        if(step->type == i2c_init_step::verify) {
+            if(!written && !CheckVerify(step->regAddr, step->mask, step->value, image[step->regAddr])) return -EIO;
+            continue;
+        }
+        written = true;
+        auto& value = image[step->regAddr];
+        value = static_cast<unsigned char>((value & ~step->mask) | (step->value & step->mask));
+
+        if(!writes.empty()) {
+            auto& last = writes.back();
+            const auto lastReg = last.first + last.second.size() - 1;
+            if(lastReg == step->regAddr) {
+                last.second.back() = value;
+                continue;
+            }
+            if(lastReg + 1 == step->regAddr) {
+                last.second.push_back(value);
+                continue;
+            }
+        }
+        writes.emplace_back(step->regAddr, std::vector<unsigned char>{value});
+    }
+    if(writes.empty() && readAfter.none()) return transactions;
+
+    std::array<unsigned char, 256> readBack{};
+    I2CTransaction transaction;
+    for(const auto& write : writes) {
+        device.AddWriteBytes(transaction, write.first, static_cast<unsigned short>(write.second.size()), write.second.data());
+    }
+    device.AddReadRegisters(transaction, readAfter, readBack.data());
+    const auto result = device.Execute(transaction);
+    if(result < 0) return result;
+    transactions++;
+
+    written = false;
+    for(auto step = begin; step != end; ++step) {
+        if(step->type != i2c_init_step::verify) {
+            written = true;
+            continue;
+        }
+        if(written && !CheckVerify(step->regAddr, step->mask, step->value, readBack[step->regAddr])) return -EIO;
+    }
+    return transactions;
+}
+
+int I2CInitSequence::Run(I2CDevice& device) const
+{
+    auto transactions = 0;
+    auto result = 0;
+    auto begin = _steps.cbegin();
+    while(result >= 0) {
+        const auto end = std::find_if(begin, _steps.cend(), [](const Step& step) { return step.type == i2c_init_step::delay; });
+        result = RunBatch(device, begin, end);
+        if(result < 0 || end == _steps.cend()) break;
+        transactions += result;
+        std::this_thread::sleep_for(end->delay);
+        begin = end + 1;
+    }
+
+    // the writes went around the shadow
+    device.InvalidateShadow();
+    if(result < 0) return result;
+    return transactions + result;
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * File:   I2CInitSequence.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include <chrono>
+#include <vector>
+
+class I2CDevice;
+
+enum class i2c_init_step {
+    // write of the masked bits, mask 0xFF is a plain write
+    write,
+    // read back and compare the masked bits
+    verify,
+    // wait, sample after a reset bit
+    delay
+};
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * I2CInitSequence register setup of a device as list of writes, masked writes
+ * and verify reads. Run sends it in as few transactions as possible: one
+ * read of all registers the masked writes and the first verifies need, then
+ * all writes (neighbour registers in one auto increment write) together with
+ * the remaining verify reads. Verifies before the first write are checked
+ * before anything is written (sample WHO_AM_I), the others after all writes.
+ * A delay step ends the batch, the steps after it start a new one.
+ */
+class I2CInitSequence
+{
+    struct Step {
+        i2c_init_step type;
+        unsigned char regAddr;
+        unsigned char mask;
+        unsigned char value;
+        std::chrono::milliseconds delay;
+    };
+
+    std::vector<Step> _steps;
+
+    int RunBatch(I2CDevice& device, std::vector<Step>::const_iterator begin, std::vector<Step>::const_iterator end) const;
+
+  public:
+    I2CInitSequence() = default;
+
+    void AddWrite(unsigned char regAddr, unsigned char value);
+    /**
+     * Change only the bits of mask, the other bits are read from the device
+     */
+    void AddWrite(unsigned char regAddr, unsigned char mask, unsigned char value);
+    /**
+     * Fail the sequence if (register & mask) != expected
+     */
+    void AddVerify(unsigned char regAddr, unsigned char mask, unsigned char expected);
+    void AddDelay(std::chrono::milliseconds delay);
+
+    /**
+     * Send the sequence, the shadow of the device is dropped afterwards
+     * @return number of transactions, < 0 error (-EIO verify failed)
+     */
+    int Run(I2CDevice& device) const;
+};
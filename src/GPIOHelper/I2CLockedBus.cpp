@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   I2CLockedBus.cpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#include "I2CLockedBus.hpp"
+#include <cstring>
+#include "I2CBus.hpp"
+
+I2CLockedBus::I2CLockedBus(I2CBus& bus, const I2CRoute& route)
+    : _bus(bus), _route(route), _messages{}, _buffer{}, _lastResult(0), _lastAddr(0), _lastRead(false)
+{
+}
+
+int I2CLockedBus::Transfer(const unsigned int count)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const auto retVal = _bus.TransferLocked(_messages, count, _route);
+    _bus._statistics.Record(_messages,
+                            count,
+                            retVal,
+                            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start));
+    _lastResult = retVal;
+    _lastAddr = static_cast<unsigned char>(_messages[0].addr);
+    _lastRead = _messages[count - 1].flags & I2C_M_RD;
+    return retVal;
+}
+
+int I2CLockedBus::ReadByte(const unsigned char deviceAddr, const unsigned char regAddr, unsigned char& value)
+{
+    return ReadBytes(deviceAddr, regAddr, 1, &value);
+}
+
+int I2CLockedBus::ReadBytes(const unsigned char deviceAddr, const unsigned char regAddr, const unsigned char length, unsigned char* value)
+{
+    _buffer[0] = regAddr;
+    _messages[0].addr = deviceAddr;
+    _messages[0].flags = 0;
+    _messages[0].len = 1;
+    _messages[0].buf = _buffer;
+    _messages[1].addr = deviceAddr;
+    _messages[1].flags = I2C_M_RD;
+    _messages[1].len = length;
+    _messages[1].buf = value;
+    return Transfer(2);
+}
+
+int I2CLockedBus::WriteByte(const unsigned char deviceAddr, const unsigned char regAddr, const unsigned char value)
+{
+    return WriteBytes(deviceAddr, regAddr, 1, &value);
+}
+
+int I2CLockedBus::WriteBytes(const unsigned char deviceAddr,
+                             const unsigned char regAddr,
+                             const unsigned char length,
+                             const unsigned char* value)
+{
+    _buffer[0] = regAddr;
+    std::memcpy(&_buffer[1], value, length);
+    _messages[0].addr = deviceAddr;
+    _messages[0].flags = 0;
+    _messages[0].len = static_cast<__u16>(length + 1);
+    _messages[0].buf = _buffer;
+    return Transfer(1);
+}
+
+int I2CLockedBus::ModifyByte(const unsigned char deviceAddr,
+                             const unsigned char regAddr,
+                             const unsigned char mask,
+                             const unsigned char value,
+                             const unsigned char* current)
+{
+    unsigned char currentValue = 0x00;
+    if(current != nullptr) {
+        currentValue = *current;
+    } else {
+        const auto result = ReadByte(deviceAddr, regAddr, currentValue);
+        if(result < 0) return result;
+    }
+
+    currentValue = static_cast<unsigned char>((currentValue & ~mask) | (value & mask));
+    return WriteByte(deviceAddr, regAddr, currentValue);
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   I2CLockedBus.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include <linux/i2c.h>
+#include "I2CRequest.hpp"
+
+class I2CBus;
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * I2CLockedBus access to a bus while I2CBus::RunLocked holds its lock
+ * Only valid inside the sequence, every call is one transfer without locking.
+ */
+class I2CLockedBus
+{
+    I2CBus& _bus;
+    I2CRoute _route;
+    // bound buffers, a register access needs no allocation
+    i2c_msg _messages[2];
+    unsigned char _buffer[256];
+    // last transfer, RunLocked reports a failed sequence with it after unlocking
+    int _lastResult;
+    unsigned char _lastAddr;
+    bool _lastRead;
+
+    friend class I2CBus;
+
+    int Transfer(unsigned int count);
+
+  public:
+    I2CLockedBus(I2CBus& bus, const I2CRoute& route);
+    I2CLockedBus(const I2CLockedBus& orig) = delete;
+    I2CLockedBus(I2CLockedBus&& other) = delete;
+    I2CLockedBus& operator=(const I2CLockedBus& other) = delete;
+    I2CLockedBus& operator=(I2CLockedBus&& other) = delete;
+    ~I2CLockedBus() = default;
+
+    int ReadByte(unsigned char deviceAddr, unsigned char regAddr, unsigned char& value);
+    int ReadBytes(unsigned char deviceAddr, unsigned char regAddr, unsigned char length, unsigned char* value);
+    int WriteByte(unsigned char deviceAddr, unsigned char regAddr, unsigned char value);
+    int WriteBytes(unsigned char deviceAddr, unsigned char regAddr, unsigned char length, const unsigned char* value);
+    /**
+     * Read the register and write back the bits of mask from value
+     * @param current
+     *    known register value, nullptr reads the register
+     */
+    int ModifyByte(unsigned char deviceAddr,
+                   unsigned char regAddr,
+                   unsigned char mask,
+                   unsigned char value,
+                   const unsigned char* current = nullptr);
+};
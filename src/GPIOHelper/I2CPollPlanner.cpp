@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   I2CPollPlanner.cpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#ifndef ELPP_DEFAULT_LOGGER
+#define ELPP_DEFAULT_LOGGER "I2CPollPlanner"
+#endif
+#ifndef ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID
+#define ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID ELPP_DEFAULT_LOGGER
+#endif
+
+#include "I2CPollPlanner.hpp"
+#include <linux/i2c.h>
+#include <algorithm>
+#include "../common/easylogging/easylogging++.h"
+#include "../common/exception/NullPointerException.hpp"
+#include "I2CBus.hpp"
+#include "I2CDevice.hpp"
+#include "I2CTiming.hpp"
+
+I2CPollPlanner::I2CPollPlanner(I2CBus* bus) : _run(false), _changed(false), _overhead(std::chrono::microseconds(50))
+{
+    el::Loggers::getLogger(ELPP_DEFAULT_LOGGER);
+    if(bus == nullptr) {
+        throw NullPointerException("bus");
+    }
+    _bus = bus;
+}
+
+I2CPollPlanner::~I2CPollPlanner()
+{
+    Stop();
+}
+
+std::chrono::nanoseconds I2CPollPlanner::FindPhase(const std::chrono::nanoseconds period, const std::chrono::nanoseconds cost) const
+{
+    if(_blocks.empty()) return std::chrono::nanoseconds(0);
+
+    auto horizon = period;
+    for(const auto& block : _blocks) {
+        horizon = std::max(horizon, block->period);
+    }
+    const auto candidates = std::max<long long>(1, std::min<long long>(64, period / std::max(cost, std::chrono::nanoseconds(1))));
+    const std::chrono::nanoseconds step = period / candidates;
+
+    // the phase with the largest distance of its reads to the nearest read of another block
+    auto bestPhase = std::chrono::nanoseconds(0);
+    auto bestDistance = std::chrono::nanoseconds(-1);
+    for(long long candidate = 0; candidate < candidates; candidate++) {
+        const std::chrono::nanoseconds phase = step * candidate;
+        std::chrono::nanoseconds distance = std::chrono::nanoseconds::max();
+        std::chrono::nanoseconds time = phase;
+        for(auto release = 0; release < 16 && time < horizon; release++, time += period) {
+            for(const auto& block : _blocks) {
+                auto offset = (time - block->phase) % block->period;
+                if(offset.count() < 0) offset += block->period;
+                distance = std::min(distance, std::min(offset, block->period - offset));
+            }
+        }
+        if(distance > bestDistance) {
+            bestDistance = distance;
+            bestPhase = phase;
+        }
+    }
+    return bestPhase;
+}
+
+int I2CPollPlanner::AddBlock(I2CDevice* device, const unsigned char regAddr, const unsigned short length, const double rate)
+{
+    if(device == nullptr || length == 0 || rate <= 0.0) {
+        LOG(ERROR) << "poll block needs a device, a length and a rate";
+        return -9;
+    }
+
+    auto block = std::make_unique<PollBlock>();
+    block->device = device;
+    block->regAddr = regAddr;
+    block->length = length;
+    block->period = std::chrono::nanoseconds(static_cast<long long>(1000000000.0 / rate));
+
+    // register address write and the read like I2CBus::ReadBytes
+    i2c_msg messages[2]{};
+    messages[0].len = 1;
+    messages[1].flags = I2C_M_RD;
+    messages[1].len = length;
+    block->cost = I2CTiming::WireTime(messages, 2, _bus->GetClockRate()) + _overhead;
+
+    int number;
+    double load = 0.0;
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        block->phase = FindPhase(block->period, block->cost);
+        if(_run) {
+            // first read on the phase grid after now
+            const auto now = std::chrono::steady_clock::now();
+            block->next = _epoch + block->phase;
+            if(block->next < now) {
+                block->next += block->period * ((now - block->next) / block->period + 1);
+            }
+        }
+        _blocks.push_back(std::move(block));
+        number = static_cast<int>(_blocks.size() - 1);
+        for(const auto& entry : _blocks) {
+            load += static_cast<double>(entry->cost.count()) / static_cast<double>(entry->period.count());
+        }
+        _changed = true;
+    }
+    _cv.notify_one();
+
+    if(load > I2C_POLL_MAX_LOAD) {
+        LOG(WARNING) << "poll rates need " << static_cast<int>(load * 100) << "% of the bus time";
+    }
+    return number;
+}
+
+int I2CPollPlanner::Subscribe(const int block, const i2c_poll_delegate& callback)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    if(block < 0 || block >= static_cast<int>(_blocks.size()) || callback == nullptr) return -9;
+    _blocks[static_cast<size_t>(block)]->subscribers.push_back(callback);
+    return 0;
+}
+
+void I2CPollPlanner::SetTransferOverhead(const std::chrono::microseconds overhead)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    for(auto& block : _blocks) {
+        block->cost += overhead - _overhead;
+    }
+    _overhead = overhead;
+}
+
+double I2CPollPlanner::GetLoad()
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    double load = 0.0;
+    for(const auto& block : _blocks) {
+        load += static_cast<double>(block->cost.count()) / static_cast<double>(block->period.count());
+    }
+    return load;
+}
+
+unsigned long I2CPollPlanner::GetOverruns(const int block)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    if(block < 0 || block >= static_cast<int>(_blocks.size())) return 0;
+    return _blocks[static_cast<size_t>(block)]->overruns;
+}
+
+void I2CPollPlanner::Start()
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    if(_run) return;
+
+    _epoch = std::chrono::steady_clock::now();
+    for(auto& block : _blocks) {
+        block->next = _epoch + block->phase;
+    }
+    _run = true;
+    _thread = std::thread(&I2CPollPlanner::PlannerLoop, this);
+}
+
+void I2CPollPlanner::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        if(!_run) return;
+        _run = false;
+    }
+    _cv.notify_one();
+    if(_thread.joinable()) {
+        _thread.join();
+    }
+
+    // the callbacks of the last reads still use the blocks
+    for(const auto& block : _blocks) {
+        while(block->inFlight) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void I2CPollPlanner::Plan(PollBlock& block, const std::chrono::steady_clock::time_point time)
+{
+    if(block.inFlight) {
+        block.overruns++;
+        return;
+    }
+
+    block.inFlight = true;
+    auto target = &block;
+    block.device->ReadBytesAsync(block.regAddr, block.length, [this, target, time](int result, const std::vector<unsigned char>& data) {
+        std::vector<i2c_poll_delegate> subscribers;
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            subscribers = target->subscribers;
+        }
+        for(const auto& subscriber : subscribers) {
+            subscriber(result, data, time);
+        }
+        target->inFlight = false;
+    });
+}
+
+void I2CPollPlanner::PlannerLoop()
+{
+    el::Helpers::setThreadName("I2CPoll");
+    std::unique_lock<std::mutex> lock(_mtx);
+
+    while(_run) {
+        if(_blocks.empty()) {
+            _cv.wait(lock, [this] { return !_run || _changed; });
+            _changed = false;
+            continue;
+        }
+
+        auto next = _blocks.front()->next;
+        for(const auto& block : _blocks) {
+            next = std::min(next, block->next);
+        }
+        if(_cv.wait_until(lock, next, [this] { return !_run || _changed; })) {
+            _changed = false;
+            continue;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        for(auto& block : _blocks) {
+            if(block->next > now) continue;
+            Plan(*block, block->next);
+            block->next += block->period;
+            if(block->next <= now) {
+                // the planner was late, skip the missed reads and keep the phase
+                const auto missed = (now - block->next) / block->period + 1;
+                block->overruns += static_cast<unsigned long>(missed);
+                block->next += block->period * missed;
+            }
+        }
+    }
+}
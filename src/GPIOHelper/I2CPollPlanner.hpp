@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   I2CPollPlanner.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class I2CBus;
+class I2CDevice;
+
+/**
+ * Bus load above this is reported, the rest is left for other accesses
+ */
+#define I2C_POLL_MAX_LOAD 0.8
+
+/**
+ * CallBack delegate for a polled register block, called from the bus worker
+ * @param result
+ *    Status of the read (0 < failed)
+ * @param data
+ *    the register bytes
+ * @param time
+ *    planned time of the read
+ */
+typedef std::function<void(int result, const std::vector<unsigned char>& data, std::chrono::steady_clock::time_point time)>
+    i2c_poll_delegate;
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * I2CPollPlanner reads register blocks of devices at fixed rates
+ * One thread plans the reads, they run on the bus worker. The phase of every new
+ * block is put where it meets the fewest reads of the other blocks, so the bus
+ * is not busy with all blocks at the same time.
+ */
+class I2CPollPlanner
+{
+    struct PollBlock {
+        I2CDevice* device;
+        unsigned char regAddr;
+        unsigned short length;
+        std::chrono::nanoseconds period;
+        std::chrono::nanoseconds phase;
+        std::chrono::nanoseconds cost;
+        std::chrono::steady_clock::time_point next;
+        std::vector<i2c_poll_delegate> subscribers;
+        std::atomic<bool> inFlight{ false };
+        std::atomic<unsigned long> overruns{ 0 };
+    };
+
+    I2CBus* _bus;
+    std::vector<std::unique_ptr<PollBlock>> _blocks;
+    std::mutex _mtx;
+    std::condition_variable _cv;
+    std::thread _thread;
+    std::chrono::steady_clock::time_point _epoch;
+    bool _run;
+    bool _changed;
+    std::chrono::microseconds _overhead;
+
+    std::chrono::nanoseconds FindPhase(std::chrono::nanoseconds period, std::chrono::nanoseconds cost) const;
+    void Plan(PollBlock& block, std::chrono::steady_clock::time_point time);
+    void PlannerLoop();
+
+  public:
+    /**
+     * Create new I2CPollPlanner
+     * @param bus
+     *    the bus see I2CBus
+     */
+    explicit I2CPollPlanner(I2CBus* bus);
+    I2CPollPlanner(const I2CPollPlanner& orig) = delete;
+    I2CPollPlanner(I2CPollPlanner&& other) = delete;
+    I2CPollPlanner& operator=(const I2CPollPlanner& other) = delete;
+    I2CPollPlanner& operator=(I2CPollPlanner&& other) = delete;
+    virtual ~I2CPollPlanner();
+
+    /**
+     * Poll a register block of a device
+     * @param device
+     *    a device on the bus of the planner, options and route of the device are used
+     * @param rate
+     *    reads per second
+     * @return block number, < 0 failed
+     */
+    int AddBlock(I2CDevice* device, unsigned char regAddr, unsigned short length, double rate);
+    /**
+     * Get the bytes of every read of the block
+     */
+    int Subscribe(int block, const i2c_poll_delegate& callback);
+    /**
+     * Time every transfer costs on top of the wire time for the load estimate (default 50us)
+     */
+    void SetTransferOverhead(std::chrono::microseconds overhead);
+    /**
+     * Estimated part of the bus time the blocks use, above 1.0 the rates can not be reached
+     */
+    double GetLoad();
+    /**
+     * Reads of the block skipped because the previous read was not done
+     */
+    unsigned long GetOverruns(int block);
+
+    void Start();
+    /**
+     * Stop planning and wait for the running reads
+     */
+    void Stop();
+};
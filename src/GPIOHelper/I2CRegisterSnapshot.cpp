@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * File:   I2CRegisterSnapshot.cpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#ifndef ELPP_DEFAULT_LOGGER
+#define ELPP_DEFAULT_LOGGER "I2CDevice"
+#endif
+#ifndef ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID
+#define ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID ELPP_DEFAULT_LOGGER
+#endif
+
+#include "I2CRegisterSnapshot.hpp"
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../common/easylogging/easylogging++.h"
+#include "I2CDevice.hpp"
+#include "I2CInitSequence.hpp"
+
+void I2CRegisterSnapshot::Set(const unsigned char regAddr, const unsigned char value, const unsigned char mask)
+{
+    const auto entry = std::find_if(_entries.begin(), _entries.end(), [regAddr](const Entry& item) { return item.regAddr == regAddr; });
+    if(entry != _entries.end()) {
+        entry->value = value;
+        entry->mask = mask;
+        return;
+    }
+    _entries.push_back(Entry{regAddr, mask, value});
+}
+
+bool I2CRegisterSnapshot::Get(const unsigned char regAddr, unsigned char& value) const
+{
+    const auto entry = std::find_if(_entries.begin(), _entries.end(), [regAddr](const Entry& item) { return item.regAddr == regAddr; });
+    if(entry == _entries.end()) return false;
+    value = entry->value;
+    return true;
+}
+
+std::size_t I2CRegisterSnapshot::Size() const
+{
+    return _entries.size();
+}
+
+void I2CRegisterSnapshot::Clear()
+{
+    _entries.clear();
+}
+
+int I2CRegisterSnapshot::Capture(I2CDevice& device)
+{
+    if(_entries.empty()) return 0;
+
+    std::bitset<256> registers;
+    for(const auto& entry : _entries) {
+        registers[entry.regAddr] = true;
+    }
+
+    std::array<unsigned char, 256> image{};
+    I2CTransaction transaction;
+    device.AddReadRegisters(transaction, registers, image.data());
+    const auto result = device.Execute(transaction);
+    if(result < 0) return result;
+
+    for(auto& entry : _entries) {
+        entry.value = image[entry.regAddr];
+    }
+    return 0;
+}
+
+int I2CRegisterSnapshot::Restore(I2CDevice& device) const
+{
+    if(_entries.empty()) return 0;
+
+    std::bitset<256> registers;
+    for(const auto& entry : _entries) {
+        registers[entry.regAddr] = true;
+    }
+
+    std::array<unsigned char, 256> image{};
+    I2CTransaction transaction;
+    device.AddReadRegisters(transaction, registers, image.data());
+    const auto result = device.Execute(transaction);
+    if(result < 0) return result;
+
+    // whole bytes from the read, so the sequence needs no second read
+    I2CInitSequence sequence;
+    auto written = 0;
+    for(const auto& entry : _entries) {
+        const auto current = image[entry.regAddr];
+        if((current & entry.mask) == (entry.value & entry.mask)) continue;
+        sequence.AddWrite(entry.regAddr, static_cast<unsigned char>((current & ~entry.mask) | (entry.value & entry.mask)));
+        sequence.AddVerify(entry.regAddr, entry.mask, entry.value);
+        written++;
+    }
+    if(written == 0) return 0;
+
+    const auto runResult = sequence.Run(device);
+    if(runResult < 0) return runResult;
+    LOG(DEBUG) << "restore wrote " << written << " of " << _entries.size() << " registers";
+    return written;
+}
+
+int I2CRegisterSnapshot::Save(const std::string& path) const
+{
+    std::ostringstream content;
+    content << "# reg mask value\n# " << _entries.size() << " registers\n" << std::hex;
+    for(const auto& entry : _entries) {
+        content << "0x" << static_cast<int>(entry.regAddr) << " 0x" << static_cast<int>(entry.mask) << " 0x"
+                << static_cast<int>(entry.value) << "\n";
+    }
+    const auto data = content.str();
+
+    // write a synced temporary file, rename it and sync the directory,
+    // after a crash or power loss there is the old file or the new one
+    const auto tempPath = path + ".tmp";
+    const auto fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if(fd < 0) {
+        const auto error = errno;
+        LOG(ERROR) << "can not write " << tempPath;
+        return -error;
+    }
+    std::size_t written = 0;
+    while(written < data.size()) {
+        const auto result = write(fd, data.data() + written, data.size() - written);
+        if(result < 0 && errno == EINTR) continue;
+        if(result < 0) break;
+        written += static_cast<std::size_t>(result);
+    }
+    auto error = written < data.size() || fsync(fd) != 0 ? errno : 0;
+    if(close(fd) != 0 && error == 0) error = errno;
+    if(error == 0 && std::rename(tempPath.c_str(), path.c_str()) != 0) error = errno;
+    if(error != 0) {
+        LOG(ERROR) << "can not save " << path << ": " << std::strerror(error);
+        std::remove(tempPath.c_str());
+        return -error;
+    }
+
+    const auto slash = path.find_last_of('/');
+    const auto directory = slash == std::string::npos ? std::string(".") : (slash == 0 ? std::string("/") : path.substr(0, slash));
+    const auto dirFd = open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if(dirFd < 0 || fsync(dirFd) != 0) {
+        error = errno;
+        LOG(ERROR) << "can not sync " << directory;
+    }
+    if(dirFd >= 0) close(dirFd);
+    return -error;
+}
+
+int I2CRegisterSnapshot::Load(const std::string& path)
+{
+    std::ifstream file(path);
+    if(!file.is_open()) return -ENOENT;
+
+    std::vector<Entry> entries;
+    std::size_t expected = 0;
+    auto counted = false;
+    std::string line;
+    while(std::getline(file, line)) {
+        if(line.empty()) continue;
+        if(line[0] == '#') {
+            // count line written by Save, a file without it is taken as it is
+            std::istringstream fields(line.substr(1));
+            std::string word;
+            if(fields >> std::dec >> expected >> word && word == "registers") counted = true;
+            continue;
+        }
+
+        std::istringstream fields(line);
+        unsigned int regAddr = 0;
+        unsigned int mask = 0;
+        unsigned int value = 0;
+        fields >> std::hex >> regAddr >> mask >> value;
+        if(fields.fail() || regAddr > 0xFF || mask > 0xFF || value > 0xFF) {
+            LOG(ERROR) << "bad line in " << path << ": " << line;
+            return -EINVAL;
+        }
+        entries.push_back(Entry{static_cast<unsigned char>(regAddr), static_cast<unsigned char>(mask), static_cast<unsigned char>(value)});
+    }
+    if(counted && entries.size() != expected) {
+        LOG(ERROR) << path << " has " << entries.size() << " of " << expected << " registers, truncated";
+        return -EINVAL;
+    }
+
+    _entries = entries;
+    return 0;
+}
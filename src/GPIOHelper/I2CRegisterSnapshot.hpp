@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * File:   I2CRegisterSnapshot.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class I2CDevice;
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * I2CRegisterSnapshot desired values of the configuration registers of one
+ * device. Restore reads all of them in one transaction and writes only the
+ * registers that differ, in the order they were set (sample output latch
+ * before direction). A device that kept power during a restart gets no write.
+ *
+ * The file format is one register per line "reg mask value" in hex, lines
+ * starting with # are comments. Save adds the line "# <n> registers", Load
+ * refuses a file with fewer registers than that.
+ *
+ * Capture and Restore read neighbouring registers in one burst, the device
+ * must auto increment its register pointer (MCP23017 checks IOCON first).
+ */
+class I2CRegisterSnapshot
+{
+    struct Entry {
+        unsigned char regAddr;
+        unsigned char mask;
+        unsigned char value;
+    };
+
+    std::vector<Entry> _entries;
+
+  public:
+    I2CRegisterSnapshot() = default;
+
+    /**
+     * Set the desired value, a register set again keeps its place in the order
+     * @param mask
+     *    bits compared and written, the others keep the device value
+     */
+    void Set(unsigned char regAddr, unsigned char value, unsigned char mask = 0xFF);
+    bool Get(unsigned char regAddr, unsigned char& value) const;
+    std::size_t Size() const;
+    void Clear();
+
+    /**
+     * Take the current values of all registers from the device, one transaction
+     * @return 0 ok, < 0 failed
+     */
+    int Capture(I2CDevice& device);
+    /**
+     * Write the registers that differ from the device and verify them
+     * @return number of written registers, < 0 failed (-EIO verify failed)
+     */
+    int Restore(I2CDevice& device) const;
+
+    /**
+     * Save writes and syncs path.tmp, renames it and syncs the directory, the old file stays on a failure
+     * @return 0 ok, < 0 negative errno (-EINVAL bad line or truncated file)
+     */
+    int Save(const std::string& path) const;
+    int Load(const std::string& path);
+};
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   I2CRequest.cpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#include "I2CRequest.hpp"
+
+void I2CRequest::Complete(const int result)
+{
+    if(callback != nullptr) {
+        if(type != i2c_request_type::read) {
+            data.clear();
+        }
+        callback(result, data);
+        return;
+    }
+    promise.set_value(result);
+}
+
+void I2CRequest::Apply(const I2CRequestOptions& options)
+{
+    priority = options.priority;
+    dropWhenLate = options.dropWhenLate;
+    mergeable = options.mergeable;
+    route = options.route;
+    if(options.maxLatency.count() > 0) {
+        deadline = std::chrono::steady_clock::now() + options.maxLatency;
+    }
+}
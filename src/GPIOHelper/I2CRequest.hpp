@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   I2CRequest.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <vector>
+
+class I2CBus;
+
+/**
+ * Result of a request dropped because its deadline had passed
+ */
+#define I2C_RESULT_DEADLINE_MISSED -62
+
+enum class i2c_request_type : int {
+    read,
+    write,
+    job
+};
+
+/**
+ * The bus worker always takes the highest class first
+ */
+enum class i2c_priority : int {
+    low,
+    normal,
+    high,
+    realtime
+};
+
+/**
+ * Path to a device behind a TCA9548A multiplexer, muxAddr 0 is a device on the bus itself
+ */
+struct I2CRoute {
+    unsigned char muxAddr{};
+    unsigned char channel{};
+
+    bool operator==(const I2CRoute& other) const
+    {
+        return muxAddr == other.muxAddr && (muxAddr == 0 || channel == other.channel);
+    }
+    bool operator!=(const I2CRoute& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * I2CRequestOptions scheduling of a request on the bus worker
+ */
+struct I2CRequestOptions {
+    i2c_priority priority = i2c_priority::normal;
+    // 0 no deadline, otherwise the request should be done this long after submit
+    std::chrono::microseconds maxLatency{ 0 };
+    // a request that can not start before its deadline completes with I2C_RESULT_DEADLINE_MISSED
+    bool dropWhenLate = false;
+    // the worker may merge the request with others of the device, see I2CBus::SetReadCoalescing
+    bool mergeable = true;
+    // the bus selects the mux channel before the transfer, see TCA9548A
+    I2CRoute route;
+};
+
+/**
+ * CallBack delegate for a finished asynchronous request, called from the bus worker
+ * @param result
+ *    Status of the operation (0 < failed)
+ * @param data
+ *    the bytes read, empty for writes
+ */
+typedef std::function<void(int result, const std::vector<unsigned char>& data)> i2c_completion_delegate;
+
+/**
+ * CallBack delegate for a request finished after its deadline, called from the bus worker
+ * @param deviceAddr
+ *    the device of the request (0 for jobs)
+ * @param late
+ *    how long after the deadline the request finished
+ */
+typedef std::function<void(unsigned char deviceAddr, std::chrono::microseconds late)> i2c_deadline_delegate;
+
+/**
+ * Work executed on the bus worker, may use the synchronous I2CBus functions
+ */
+typedef std::function<int(I2CBus& bus)> i2c_job_delegate;
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * I2CRequest one queued operation of the bus worker
+ */
+struct I2CRequest {
+    std::atomic<I2CRequest*> next{ nullptr };
+    i2c_request_type type{ i2c_request_type::read };
+    unsigned char deviceAddr{};
+    unsigned char regAddr{};
+    unsigned short length{};
+    // caller memory to read into, nullptr reads into data
+    unsigned char* buffer{};
+    // bytes to write, or the read result without caller buffer
+    std::vector<unsigned char> data;
+    i2c_job_delegate job;
+    i2c_completion_delegate callback;
+    std::promise<int> promise;
+    i2c_priority priority{ i2c_priority::normal };
+    // time_point() means no deadline
+    std::chrono::steady_clock::time_point deadline;
+    bool dropWhenLate{};
+    bool mergeable{ true };
+    I2CRoute route;
+    unsigned long long sequence{};
+
+    /**
+     * Take over the options, the deadline counts from now
+     */
+    void Apply(const I2CRequestOptions& options);
+
+    /**
+     * Hand the result to the callback or the future
+     */
+    void Complete(int result);
+};
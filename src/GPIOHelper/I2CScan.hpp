@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   I2CScan.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include <functional>
+#include <string>
+
+class I2CBus;
+
+/**
+ * First and last 7 bit address of a bus scan, the others are reserved
+ */
+#define I2C_SCAN_FIRST 0x03
+#define I2C_SCAN_LAST 0x77
+
+/**
+ * Check whether the device at the address is a known chip, sample MCP23017::Identify
+ * @return true the chip is identified
+ */
+typedef std::function<bool(I2CBus& bus, unsigned char deviceAddr)> i2c_identify_delegate;
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * I2CScanEntry one answering device of I2CBus::Scan
+ */
+struct I2CScanEntry {
+    unsigned char address{};
+    // name of the matching identify probe, empty if unknown
+    std::string type;
+};
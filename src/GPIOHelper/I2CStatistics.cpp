@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   I2CStatistics.cpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#include "I2CStatistics.hpp"
+#include <linux/i2c.h>
+#include <algorithm>
+#include <cerrno>
+#include <iomanip>
+#include "I2CTiming.hpp"
+
+static unsigned int LatencyBucket(const std::chrono::microseconds latency)
+{
+    unsigned int bucket = 0;
+    auto value = static_cast<unsigned long>(latency.count()) >> 1;
+    while(value > 0 && bucket < I2C_LATENCY_BUCKETS - 1) {
+        value >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+static long long SlotIndex(const std::chrono::steady_clock::time_point time)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count() / I2C_UTILISATION_SLOT_MS;
+}
+
+void I2CStatisticsCollector::SetClockRate(const unsigned int clockRate)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    _clockRate = clockRate;
+}
+
+void I2CStatisticsCollector::RecordLockWait(const std::chrono::microseconds lockWait)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    _lockAcquisitions++;
+    _lockWaitTotal += lockWait;
+    if(lockWait > _lockWaitMax) _lockWaitMax = lockWait;
+}
+
+void I2CStatisticsCollector::Record(const i2c_msg* messages,
+                                    const unsigned int count,
+                                    const int result,
+                                    const std::chrono::microseconds latency)
+{
+    const auto bucket = LatencyBucket(latency);
+    const auto nack = result == -ENXIO || result == -EREMOTEIO;
+    const auto slotIndex = SlotIndex(std::chrono::steady_clock::now());
+
+    std::lock_guard<std::mutex> lock(_mtx);
+
+    const auto wireTime = I2CTiming::WireTime(messages, count, _clockRate);
+    auto& slot = _slots[static_cast<std::size_t>(slotIndex % I2C_UTILISATION_SLOTS)];
+    if(slot.index != slotIndex) slot = UtilisationSlot{slotIndex};
+    slot.transfers++;
+    slot.wireTime += wireTime;
+    slot.busyTime += latency;
+    if(result >= 0 && _clockRate != 0) {
+        const auto overhead = std::max(std::chrono::nanoseconds(latency) - wireTime, std::chrono::nanoseconds(0));
+        if(!_overheadKnown || overhead < _overheadMin) _overheadMin = overhead;
+        _overheadKnown = true;
+    }
+
+    for(unsigned int index = 0; index < count; index++) {
+        const auto addr = messages[index].addr & 0x7F;
+        auto& device = _devices[addr];
+        if(messages[index].flags & I2C_M_RD) {
+            if(result >= 0) device.bytesRead += messages[index].len;
+        } else {
+            if(result >= 0) device.bytesWritten += messages[index].len;
+        }
+
+        // transaction, latency and errors once per device of the transfer
+        auto first = true;
+        for(unsigned int before = 0; before < index; before++) {
+            if((messages[before].addr & 0x7F) == addr) {
+                first = false;
+                break;
+            }
+        }
+        if(!first) continue;
+
+        device.transactions++;
+        device.totalLatency += latency;
+        if(latency > device.maxLatency) device.maxLatency = latency;
+        device.latencyHistogram[bucket]++;
+        device.wireTime += wireTime;
+        if(result < 0) {
+            device.errors++;
+            if(nack) device.nacks++;
+        }
+    }
+}
+
+I2CBusStatistics I2CStatisticsCollector::Snapshot()
+{
+    I2CBusStatistics statistics;
+    std::lock_guard<std::mutex> lock(_mtx);
+    for(unsigned char addr = 0; addr < 128; addr++) {
+        if(_devices[addr].transactions == 0) continue;
+        statistics.devices[addr] = _devices[addr];
+    }
+    statistics.lockAcquisitions = _lockAcquisitions;
+    statistics.lockWaitTotal = _lockWaitTotal;
+    statistics.lockWaitMax = _lockWaitMax;
+    statistics.utilisation = UtilisationLocked(std::chrono::steady_clock::now());
+    statistics.overheadMin = _overheadMin;
+    return statistics;
+}
+
+I2CBusUtilisation I2CStatisticsCollector::Utilisation()
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    return UtilisationLocked(std::chrono::steady_clock::now());
+}
+
+I2CBusUtilisation I2CStatisticsCollector::UtilisationLocked(const std::chrono::steady_clock::time_point now) const
+{
+    // the running slot is not full, take the ones before it
+    const auto current = SlotIndex(now);
+    I2CBusUtilisation utilisation;
+    utilisation.window = std::chrono::milliseconds(I2C_UTILISATION_SLOTS * I2C_UTILISATION_SLOT_MS);
+    for(const auto& slot : _slots) {
+        if(slot.index < current - I2C_UTILISATION_SLOTS || slot.index >= current) continue;
+        utilisation.transfers += slot.transfers;
+        utilisation.wireTime += slot.wireTime;
+        utilisation.busyTime += slot.busyTime;
+    }
+
+    const auto window = static_cast<double>(std::chrono::nanoseconds(utilisation.window).count());
+    utilisation.wireLoad = utilisation.wireTime.count() / window;
+    utilisation.busyLoad = utilisation.busyTime.count() / window;
+    if(utilisation.transfers > 0) {
+        utilisation.overheadAvg = (utilisation.busyTime - utilisation.wireTime) / static_cast<long>(utilisation.transfers);
+    }
+    return utilisation;
+}
+
+std::vector<unsigned char> I2CStatisticsCollector::SlowDevices(const std::chrono::microseconds threshold)
+{
+    std::vector<unsigned char> devices;
+    std::lock_guard<std::mutex> lock(_mtx);
+    if(_clockRate == 0 || !_overheadKnown) return devices;
+
+    for(unsigned char addr = 0; addr < 128; addr++) {
+        const auto& device = _devices[addr];
+        if(device.transactions == 0) continue;
+        const auto excess = (std::chrono::nanoseconds(device.totalLatency) - device.wireTime) / static_cast<long>(device.transactions);
+        if(excess > _overheadMin + threshold) devices.push_back(addr);
+    }
+    return devices;
+}
+
+void I2CStatisticsCollector::Reset()
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    _devices.fill(I2CDeviceStatistics());
+    _lockAcquisitions = 0;
+    _lockWaitTotal = std::chrono::microseconds(0);
+    _lockWaitMax = std::chrono::microseconds(0);
+    _overheadMin = std::chrono::nanoseconds(0);
+    _overheadKnown = false;
+    _slots.fill(UtilisationSlot());
+}
+
+std::ostream& operator<<(std::ostream& os, const I2CBusUtilisation& utilisation)
+{
+    const auto flags = os.flags();
+    os << "utilisation wire " << std::fixed << std::setprecision(1) << utilisation.wireLoad * 100.0 << "% busy "
+       << utilisation.busyLoad * 100.0 << "% in " << utilisation.window.count() << "ms, " << utilisation.transfers
+       << " transfers, overhead avg " << utilisation.overheadAvg.count() / 1000 << "us";
+    os.flags(flags);
+    return os;
+}
+
+std::ostream& operator<<(std::ostream& os, const I2CBusStatistics& statistics)
+{
+    os << "lock " << statistics.lockAcquisitions << " wait total " << statistics.lockWaitTotal.count() << "us max "
+       << statistics.lockWaitMax.count() << "us";
+    os << "\n  " << statistics.utilisation << " min " << statistics.overheadMin.count() / 1000 << "us";
+    for(const auto& entry : statistics.devices) {
+        const auto& device = entry.second;
+        os << "\n  0x" << std::hex << static_cast<int>(entry.first) << std::dec << " transactions " << device.transactions
+           << " read " << device.bytesRead << " written " << device.bytesWritten << " errors " << device.errors << " nacks "
+           << device.nacks << " latency avg " << device.totalLatency.count() / static_cast<long>(device.transactions)
+           << "us max " << device.maxLatency.count() << "us wire avg "
+           << device.wireTime.count() / 1000 / static_cast<long>(device.transactions) << "us";
+    }
+    return os;
+}
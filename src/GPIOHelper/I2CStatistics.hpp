@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   I2CStatistics.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include <array>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+struct i2c_msg;
+
+/**
+ * Number of latency buckets, bucket n counts transfers below 2^(n+1) microseconds, the last one all slower
+ */
+#define I2C_LATENCY_BUCKETS 16
+
+/**
+ * Rolling utilisation window, I2C_UTILISATION_SLOTS slots of I2C_UTILISATION_SLOT_MS
+ */
+#define I2C_UTILISATION_SLOTS 10
+#define I2C_UTILISATION_SLOT_MS 100
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * I2CDeviceStatistics traffic of one address
+ * A failing transfer with messages for several devices counts as error for each of them.
+ */
+struct I2CDeviceStatistics {
+    unsigned long transactions{};
+    unsigned long bytesRead{};
+    unsigned long bytesWritten{};
+    unsigned long errors{};
+    unsigned long nacks{};
+    std::chrono::microseconds totalLatency{};
+    std::chrono::microseconds maxLatency{};
+    std::array<unsigned long, I2C_LATENCY_BUCKETS> latencyHistogram{};
+    // estimated wire time of the transfers (see I2CTiming), like totalLatency for the whole transfer
+    std::chrono::nanoseconds wireTime{};
+};
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * I2CBusUtilisation share of the bus clock used in the last window
+ * wireLoad is the estimated time on the wire, busyLoad the measured time of the
+ * transport calls, the difference is driver overhead (and clock stretching).
+ */
+struct I2CBusUtilisation {
+    std::chrono::milliseconds window{};
+    unsigned long transfers{};
+    std::chrono::nanoseconds wireTime{};
+    std::chrono::nanoseconds busyTime{};
+    double wireLoad{};
+    double busyLoad{};
+    // average of measured minus wire time per transfer
+    std::chrono::nanoseconds overheadAvg{};
+};
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * I2CBusStatistics snapshot of the traffic of one bus, see I2CBus::GetStatistics
+ */
+struct I2CBusStatistics {
+    // only addresses that had traffic
+    std::map<unsigned char, I2CDeviceStatistics> devices;
+    unsigned long lockAcquisitions{};
+    std::chrono::microseconds lockWaitTotal{};
+    std::chrono::microseconds lockWaitMax{};
+    I2CBusUtilisation utilisation;
+    // smallest measured minus wire time of a good transfer, the fixed cost of the driver
+    std::chrono::nanoseconds overheadMin{};
+};
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * I2CStatisticsCollector counts the transfers of a bus, thread safe
+ */
+class I2CStatisticsCollector
+{
+    std::array<I2CDeviceStatistics, 128> _devices{};
+    unsigned long _lockAcquisitions{};
+    std::chrono::microseconds _lockWaitTotal{};
+    std::chrono::microseconds _lockWaitMax{};
+    unsigned int _clockRate{};
+    std::chrono::nanoseconds _overheadMin{};
+    bool _overheadKnown{};
+    struct UtilisationSlot {
+        long long index{-1};
+        unsigned long transfers{};
+        std::chrono::nanoseconds wireTime{};
+        std::chrono::nanoseconds busyTime{};
+    };
+    std::array<UtilisationSlot, I2C_UTILISATION_SLOTS> _slots{};
+    std::mutex _mtx;
+
+    I2CBusUtilisation UtilisationLocked(std::chrono::steady_clock::time_point now) const;
+
+  public:
+    /**
+     * Bus clock in Hz for the wire time, 0 no estimate
+     */
+    void SetClockRate(unsigned int clockRate);
+    /**
+     * Count one combined transfer
+     * @param result
+     *    the transport result, < 0 negative errno
+     * @param latency
+     *    time of the transport call
+     */
+    void Record(const i2c_msg* messages, unsigned int count, int result, std::chrono::microseconds latency);
+    /**
+     * Count one acquisition of the bus lock
+     * @param lockWait
+     *    time waited for the lock
+     */
+    void RecordLockWait(std::chrono::microseconds lockWait);
+    I2CBusStatistics Snapshot();
+    /**
+     * Utilisation of the last I2C_UTILISATION_SLOTS full slots
+     */
+    I2CBusUtilisation Utilisation();
+    /**
+     * Devices whose transfers take on average longer than wire time plus the
+     * minimal driver overhead plus threshold, sample clock stretching.
+     * Mux channel selects count to the transfer, routed devices look slower.
+     */
+    std::vector<unsigned char> SlowDevices(std::chrono::microseconds threshold);
+    void Reset();
+};
+
+std::ostream& operator<<(std::ostream& os, const I2CBusUtilisation& utilisation);
+
+std::ostream& operator<<(std::ostream& os, const I2CBusStatistics& statistics);
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   I2CStatus.cpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#include "I2CStatus.hpp"
+#include <cerrno>
+#include "I2CRequest.hpp"
+
+i2c_status I2CStatusOf(const int result)
+{
+    if(result >= 0) return i2c_status::ok;
+    switch(result) {
+    case -ENXIO:
+    case -EREMOTEIO:
+        return i2c_status::nack;
+    case -ETIMEDOUT:
+        return i2c_status::timeout;
+    case -EAGAIN:
+        return i2c_status::arbitration_lost;
+    case -9:
+        return i2c_status::invalid_argument;
+    case I2C_RESULT_DEADLINE_MISSED:
+        return i2c_status::deadline_missed;
+    default:
+        return i2c_status::bus_error;
+    }
+}
+
+std::ostream& operator<<(std::ostream& os, const i2c_status status)
+{
+    switch(status) {
+    case i2c_status::ok:
+        os << "ok";
+        break;
+    case i2c_status::nack:
+        os << "nack";
+        break;
+    case i2c_status::timeout:
+        os << "timeout";
+        break;
+    case i2c_status::arbitration_lost:
+        os << "arbitration lost";
+        break;
+    case i2c_status::bus_error:
+        os << "bus error";
+        break;
+    case i2c_status::invalid_argument:
+        os << "invalid argument";
+        break;
+    case i2c_status::deadline_missed:
+        os << "deadline missed";
+        break;
+    }
+    return os;
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   I2CStatus.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include <ostream>
+
+/**
+ * Result of an I2C access in one byte, see I2CStatusOf
+ */
+enum class i2c_status : unsigned char {
+    ok,
+    nack,
+    timeout,
+    arbitration_lost,
+    bus_error,
+    invalid_argument,
+    deadline_missed
+};
+
+/**
+ * Number of i2c_status values
+ */
+#define I2C_STATUS_COUNT 7
+
+/**
+ * Map a bus result (count or negative errno) to a status
+ */
+i2c_status I2CStatusOf(int result);
+std::ostream& operator<<(std::ostream& os, i2c_status status);
@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   I2CTiming.cpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#include "I2CTiming.hpp"
+#include <linux/i2c.h>
+
+unsigned long I2CTiming::WireBits(const i2c_msg* messages, const unsigned int count)
+{
+    unsigned long bits = 1; // stop
+    for(unsigned int index = 0; index < count; index++) {
+        bits += 1 + 9 + 9UL * messages[index].len;
+    }
+    return bits;
+}
+
+std::chrono::nanoseconds I2CTiming::WireTime(const i2c_msg* messages, const unsigned int count, const unsigned int clockRate)
+{
+    return WireTime(WireBits(messages, count), clockRate);
+}
+
+std::chrono::nanoseconds I2CTiming::WireTime(const unsigned long bits, const unsigned int clockRate)
+{
+    if(clockRate == 0) return std::chrono::nanoseconds(0);
+    return std::chrono::nanoseconds(bits * 1000000000ULL / clockRate);
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   I2CTiming.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include <chrono>
+
+struct i2c_msg;
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * I2CTiming estimates the time a transfer needs on the wire
+ */
+class I2CTiming
+{
+  public:
+    /**
+     * Clock cycles of a combined transfer: a (repeated) start, address byte
+     * and ack for every message, 9 clocks per data byte and one stop
+     */
+    static unsigned long WireBits(const i2c_msg* messages, unsigned int count);
+    static std::chrono::nanoseconds WireTime(const i2c_msg* messages, unsigned int count, unsigned int clockRate);
+    static std::chrono::nanoseconds WireTime(unsigned long bits, unsigned int clockRate);
+};
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   I2CTransaction.cpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#include "I2CTransaction.hpp"
+
+void I2CTransaction::AddReadByte(const unsigned char deviceAddr, const unsigned char regAddr, unsigned char& value)
+{
+    AddReadBytes(deviceAddr, regAddr, 1, &value);
+}
+
+void I2CTransaction::AddReadBytes(const unsigned char deviceAddr,
+                                  const unsigned char regAddr,
+                                  const unsigned short length,
+                                  unsigned char* value)
+{
+    Entry entry{ deviceAddr, _writeData.size(), 1, value, length };
+    _writeData.push_back(regAddr);
+    _entries.push_back(entry);
+}
+
+void I2CTransaction::AddWriteByte(const unsigned char deviceAddr, const unsigned char regAddr, const unsigned char value)
+{
+    AddWriteBytes(deviceAddr, regAddr, 1, &value);
+}
+
+void I2CTransaction::AddWriteBytes(const unsigned char deviceAddr,
+                                   const unsigned char regAddr,
+                                   const unsigned short length,
+                                   const unsigned char* value)
+{
+    Entry entry{ deviceAddr, _writeData.size(), static_cast<unsigned short>(length + 1), nullptr, 0 };
+    _writeData.push_back(regAddr);
+    _writeData.insert(_writeData.end(), value, value + length);
+    _entries.push_back(entry);
+}
+
+void I2CTransaction::Clear()
+{
+    _entries.clear();
+    _writeData.clear();
+}
+
+bool I2CTransaction::Empty() const
+{
+    return _entries.empty();
+}
+
+void I2CTransaction::BuildMessages(std::vector<i2c_msg>& messages, std::vector<unsigned char>& groups)
+{
+    messages.clear();
+    groups.clear();
+    messages.reserve(_entries.size() * 2);
+    groups.reserve(_entries.size());
+
+    // the write data is complete now, so the pointers into it stay valid
+    for(const auto& entry : _entries) {
+        i2c_msg message{};
+        message.addr = entry.deviceAddr;
+        message.flags = 0;
+        message.len = entry.writeLength;
+        message.buf = &_writeData[entry.writeOffset];
+        messages.push_back(message);
+
+        if(entry.readBuffer == nullptr) {
+            groups.push_back(1);
+            continue;
+        }
+
+        message.flags = I2C_M_RD;
+        message.len = entry.readLength;
+        message.buf = entry.readBuffer;
+        messages.push_back(message);
+        groups.push_back(2);
+    }
+}
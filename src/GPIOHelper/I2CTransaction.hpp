@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   I2CTransaction.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include <linux/i2c.h>
+#include <cstddef>
+#include <vector>
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * I2CTransaction collects register reads and writes, for one or more devices
+ * on the same bus, that I2CBus::Execute sends with as few I2C_RDWR ioctls as
+ * the kernel message limit allows. Read results go straight to the caller
+ * buffers, they must stay valid until Execute returns.
+ */
+class I2CTransaction
+{
+    struct Entry {
+        unsigned char deviceAddr;
+        std::size_t writeOffset;
+        unsigned short writeLength;
+        unsigned char* readBuffer;
+        unsigned short readLength;
+    };
+
+    std::vector<Entry> _entries;
+    std::vector<unsigned char> _writeData;
+
+  public:
+    I2CTransaction() = default;
+
+    void AddReadByte(unsigned char deviceAddr, unsigned char regAddr, unsigned char& value);
+    void AddReadBytes(unsigned char deviceAddr, unsigned char regAddr, unsigned short length, unsigned char* value);
+    void AddWriteByte(unsigned char deviceAddr, unsigned char regAddr, unsigned char value);
+    void AddWriteBytes(unsigned char deviceAddr, unsigned char regAddr, unsigned short length, const unsigned char* value);
+
+    void Clear();
+    bool Empty() const;
+
+    /**
+     * Fill the i2c messages, a read is a register write followed by a read message
+     * @param messages
+     *    replaced by the messages, valid until the transaction is changed
+     * @param groups
+     *    number of messages belonging together for every entry, a group must not be split over two ioctls
+     */
+    void BuildMessages(std::vector<i2c_msg>& messages, std::vector<unsigned char>& groups);
+};
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   I2CTransport.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+
+#include <cerrno>
+
+struct i2c_msg;
+
+/**
+ * Way a register access goes to the adapter, see I2CBus::SetTransferPaths
+ */
+enum class i2c_transfer_path : int {
+    // I2C_RDWR combined transfer with repeated start
+    rdwr,
+    // I2C_SMBUS i2c block read / write, at most 32 bytes per call, longer accesses are split
+    // (a pointer only write has no SMBus form)
+    smbus_block,
+    // write() and read() after I2C_SLAVE, a stop between register and data
+    plain
+};
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * I2CTransport moves i2c messages over a bus, I2CBus sits on top of it
+ * see LinuxI2CTransport (/dev/i2c-N) and SimI2CTransport (in memory devices)
+ */
+class I2CTransport
+{
+  public:
+    virtual ~I2CTransport() = default;
+
+    /**
+     * Send the messages as one combined transfer (repeated start, one stop), like I2C_RDWR
+     * @return number of messages done, < 0 the negative errno (ENXIO / EREMOTEIO for no ack)
+     */
+    virtual int Transfer(i2c_msg* messages, unsigned int count) = 0;
+    /**
+     * SMBus i2c block access, length 1 - 32
+     * @return 0 ok, < 0 the negative errno
+     */
+    virtual int SmbusReadBlock(unsigned char deviceAddr, unsigned char regAddr, unsigned char* value, unsigned char length)
+    {
+        return -EOPNOTSUPP;
+    }
+    virtual int SmbusWriteBlock(unsigned char deviceAddr, unsigned char regAddr, const unsigned char* value, unsigned char length)
+    {
+        return -EOPNOTSUPP;
+    }
+    /**
+     * Register write, stop, then a read of length bytes
+     * @return 0 ok, < 0 the negative errno
+     */
+    virtual int PlainRead(unsigned char deviceAddr, unsigned char regAddr, unsigned char* value, unsigned short length)
+    {
+        return -EOPNOTSUPP;
+    }
+    /**
+     * One write of the bytes, the first is the register
+     */
+    virtual int PlainWrite(unsigned char deviceAddr, const unsigned char* data, unsigned short length)
+    {
+        return -EOPNOTSUPP;
+    }
+    /**
+     * Adapter functionality bits (I2C_FUNC_*)
+     */
+    virtual unsigned long Functionality() = 0;
+    /**
+     * Bus clock in Hz, used to estimate the wire time
+     */
+    virtual unsigned int ClockRate() const = 0;
+};
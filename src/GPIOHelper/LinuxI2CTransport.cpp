@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   LinuxI2CTransport.cpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+// https://www.mjmwired.net/kernel/Documentation/i2c/dev-interface
+
+#ifndef ELPP_DEFAULT_LOGGER
+#define ELPP_DEFAULT_LOGGER "I2CBus"
+#endif
+#ifndef ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID
+#define ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID ELPP_DEFAULT_LOGGER
+#endif
+
+#include "LinuxI2CTransport.hpp"
+#include <fcntl.h> //Needed for I2C port
+#include <linux/i2c-dev.h> //Needed for I2C port
+#include <linux/i2c.h>
+#include <sys/ioctl.h> //Needed for I2C port
+#include <unistd.h> //Needed for I2C port
+#include <cerrno>
+#include <cstring>
+#include "../common/easylogging/easylogging++.h"
+#include "../common/exception/ConfigErrorException.hpp"
+
+LinuxI2CTransport::LinuxI2CTransport(const std::string& device, const unsigned int clockRate) : _clockRate(clockRate), _slaveAddr(-1)
+{
+    el::Loggers::getLogger(ELPP_DEFAULT_LOGGER);
+    _i2cBusHandle = open(device.c_str(), O_RDWR);
+
+    if(_i2cBusHandle < 0) {
+        LOG(ERROR) << device << "Port open Failed";
+        std::string errmsg = device + std::string(" Port open Failed");
+        throw ConfigErrorException(errmsg);
+    }
+}
+
+LinuxI2CTransport::~LinuxI2CTransport()
+{
+    if(_i2cBusHandle > 0) {
+        close(_i2cBusHandle);
+    }
+}
+
+int LinuxI2CTransport::Transfer(i2c_msg* messages, const unsigned int count)
+{
+    struct i2c_rdwr_ioctl_data packets {
+        .msgs = messages, .nmsgs = count
+    };
+
+    const auto retVal = ioctl(_i2cBusHandle, I2C_RDWR, &packets);
+    if(retVal < 0) return -errno;
+    return retVal;
+}
+
+int LinuxI2CTransport::SelectSlave(const unsigned char deviceAddr)
+{
+    if(_slaveAddr == deviceAddr) return 0;
+    if(ioctl(_i2cBusHandle, I2C_SLAVE, deviceAddr) < 0) {
+        _slaveAddr = -1;
+        return -errno;
+    }
+    _slaveAddr = deviceAddr;
+    return 0;
+}
+
+int LinuxI2CTransport::SmbusReadBlock(const unsigned char deviceAddr,
+                                      const unsigned char regAddr,
+                                      unsigned char* value,
+                                      const unsigned char length)
+{
+    if(length == 0 || length > I2C_SMBUS_BLOCK_MAX) return -EINVAL;
+    const auto selected = SelectSlave(deviceAddr);
+    if(selected < 0) return selected;
+
+    union i2c_smbus_data data {};
+    data.block[0] = length;
+    struct i2c_smbus_ioctl_data packet {};
+    packet.read_write = I2C_SMBUS_READ;
+    packet.command = regAddr;
+    packet.size = I2C_SMBUS_I2C_BLOCK_DATA;
+    packet.data = &data;
+    if(ioctl(_i2cBusHandle, I2C_SMBUS, &packet) < 0) return -errno;
+
+    std::memcpy(value, &data.block[1], length);
+    return 0;
+}
+
+int LinuxI2CTransport::SmbusWriteBlock(const unsigned char deviceAddr,
+                                       const unsigned char regAddr,
+                                       const unsigned char* value,
+                                       const unsigned char length)
+{
+    if(length == 0 || length > I2C_SMBUS_BLOCK_MAX) return -EINVAL;
+    const auto selected = SelectSlave(deviceAddr);
+    if(selected < 0) return selected;
+
+    union i2c_smbus_data data {};
+    data.block[0] = length;
+    std::memcpy(&data.block[1], value, length);
+    struct i2c_smbus_ioctl_data packet {};
+    packet.read_write = I2C_SMBUS_WRITE;
+    packet.command = regAddr;
+    packet.size = I2C_SMBUS_I2C_BLOCK_DATA;
+    packet.data = &data;
+    if(ioctl(_i2cBusHandle, I2C_SMBUS, &packet) < 0) return -errno;
+    return 0;
+}
+
+int LinuxI2CTransport::PlainRead(const unsigned char deviceAddr,
+                                 const unsigned char regAddr,
+                                 unsigned char* value,
+                                 const unsigned short length)
+{
+    const auto selected = SelectSlave(deviceAddr);
+    if(selected < 0) return selected;
+
+    if(write(_i2cBusHandle, &regAddr, 1) != 1) return errno != 0 ? -errno : -EIO;
+    if(read(_i2cBusHandle, value, length) != length) return errno != 0 ? -errno : -EIO;
+    return 0;
+}
+
+int LinuxI2CTransport::PlainWrite(const unsigned char deviceAddr, const unsigned char* data, const unsigned short length)
+{
+    const auto selected = SelectSlave(deviceAddr);
+    if(selected < 0) return selected;
+
+    if(write(_i2cBusHandle, data, length) != length) return errno != 0 ? -errno : -EIO;
+    return 0;
+}
+
+unsigned long LinuxI2CTransport::Functionality()
+{
+    unsigned long funcs = 0;
+    if(ioctl(_i2cBusHandle, I2C_FUNCS, &funcs) < 0) {
+        LOG(WARNING) << "I2C_FUNCS failed, assume plain i2c";
+        return I2C_FUNC_I2C;
+    }
+    return funcs;
+}
+
+unsigned int LinuxI2CTransport::ClockRate() const
+{
+    return _clockRate;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   LinuxI2CTransport.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include <string>
+#include "I2CTransport.hpp"
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * LinuxI2CTransport i2c-dev character device (/dev/i2c-N)
+ */
+class LinuxI2CTransport : public I2CTransport
+{
+    int _i2cBusHandle{};
+    unsigned int _clockRate;
+    // address of the last I2C_SLAVE, -1 none
+    int _slaveAddr;
+
+    int SelectSlave(unsigned char deviceAddr);
+
+  public:
+    /**
+     * Open the bus
+     * @param device
+     *    string to device tree sample /dev/i2c-1
+     * @param clockRate
+     *    the configured bus clock (dtparam i2c_arm_baudrate), not readable from i2c-dev
+     */
+    explicit LinuxI2CTransport(const std::string& device, unsigned int clockRate = 100000);
+    LinuxI2CTransport(const LinuxI2CTransport& orig) = delete;
+    LinuxI2CTransport(LinuxI2CTransport&& other) = delete;
+    LinuxI2CTransport& operator=(const LinuxI2CTransport& other) = delete;
+    LinuxI2CTransport& operator=(LinuxI2CTransport&& other) = delete;
+    ~LinuxI2CTransport() override;
+
+    int Transfer(i2c_msg* messages, unsigned int count) override;
+    int SmbusReadBlock(unsigned char deviceAddr, unsigned char regAddr, unsigned char* value, unsigned char length) override;
+    int SmbusWriteBlock(unsigned char deviceAddr, unsigned char regAddr, const unsigned char* value, unsigned char length) override;
+    int PlainRead(unsigned char deviceAddr, unsigned char regAddr, unsigned char* value, unsigned short length) override;
+    int PlainWrite(unsigned char deviceAddr, const unsigned char* data, unsigned short length) override;
+    unsigned long Functionality() override;
+    unsigned int ClockRate() const override;
+};
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * File:   LinuxSpiTransport.cpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+// https://www.kernel.org/doc/Documentation/spi/spidev
+
+#ifndef ELPP_DEFAULT_LOGGER
+#define ELPP_DEFAULT_LOGGER "SpiBus"
+#endif
+#ifndef ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID
+#define ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID ELPP_DEFAULT_LOGGER
+#endif
+
+#include "LinuxSpiTransport.hpp"
+#include <fcntl.h>
+#include <linux/spi/spidev.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <cerrno>
+#include "../common/easylogging/easylogging++.h"
+#include "../common/exception/ConfigErrorException.hpp"
+
+LinuxSpiTransport::LinuxSpiTransport(const std::string& device,
+                                     const unsigned char mode,
+                                     const unsigned int speedHz,
+                                     const unsigned char bitsPerWord)
+    : _speedHz(speedHz)
+{
+    el::Loggers::getLogger(ELPP_DEFAULT_LOGGER);
+    _spiHandle = open(device.c_str(), O_RDWR);
+
+    if(_spiHandle < 0) {
+        LOG(ERROR) << device << " Port open Failed";
+        throw ConfigErrorException(device + std::string(" Port open Failed"));
+    }
+
+    auto modeValue = mode;
+    auto bitsValue = bitsPerWord;
+    auto speedValue = speedHz;
+    if(ioctl(_spiHandle, SPI_IOC_WR_MODE, &modeValue) < 0 || ioctl(_spiHandle, SPI_IOC_WR_BITS_PER_WORD, &bitsValue) < 0 ||
+       ioctl(_spiHandle, SPI_IOC_WR_MAX_SPEED_HZ, &speedValue) < 0) {
+        close(_spiHandle);
+        _spiHandle = -1;
+        LOG(ERROR) << device << " mode, word size or speed not supported";
+        throw ConfigErrorException(device + std::string(" mode, word size or speed not supported"));
+    }
+}
+
+LinuxSpiTransport::~LinuxSpiTransport()
+{
+    if(_spiHandle > 0) {
+        close(_spiHandle);
+    }
+}
+
+int LinuxSpiTransport::Transfer(spi_ioc_transfer* segments, const unsigned int count)
+{
+    const auto retVal = ioctl(_spiHandle, SPI_IOC_MESSAGE(count), segments);
+    if(retVal < 0) return -errno;
+    return retVal;
+}
+
+unsigned int LinuxSpiTransport::SpeedHz() const
+{
+    return _speedHz;
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * File:   LinuxSpiTransport.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include <string>
+#include "SpiTransport.hpp"
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * LinuxSpiTransport spidev character device (/dev/spidevB.C)
+ */
+class LinuxSpiTransport : public SpiTransport
+{
+    int _spiHandle{};
+    unsigned int _speedHz;
+
+  public:
+    /**
+     * Open the device and set mode, clock and word size
+     * @param device
+     *    sample /dev/spidev0.0 (bus 0, chip select 0)
+     * @param mode
+     *    SPI_MODE_0 - SPI_MODE_3
+     */
+    LinuxSpiTransport(const std::string& device, unsigned char mode, unsigned int speedHz, unsigned char bitsPerWord);
+    LinuxSpiTransport(const LinuxSpiTransport& orig) = delete;
+    LinuxSpiTransport(LinuxSpiTransport&& other) = delete;
+    LinuxSpiTransport& operator=(const LinuxSpiTransport& other) = delete;
+    LinuxSpiTransport& operator=(LinuxSpiTransport&& other) = delete;
+    ~LinuxSpiTransport() override;
+
+    int Transfer(spi_ioc_transfer* segments, unsigned int count) override;
+    unsigned int SpeedHz() const override;
+};
@@ -32,18 +32,103 @@
 #include "../common/easylogging/easylogging++.h"
 #include "../common/exception/ConfigErrorException.hpp"
 #include <bitset>
+#include <cerrno>
 #include "MCP23017.hpp"
 #include "GpioPin.hpp"
+#include "I2CInitSequence.hpp"
 #include <iostream>
 
 MCP23017::MCP23017(I2CBus* bus, unsigned char deviceAddr) {
     el::Loggers::getLogger(ELPP_DEFAULT_LOGGER);
     _device = new I2CDevice(bus, deviceAddr);
+    // direction and output latch only change by our writes
+    _device->SetRegisterCacheable(0x00, 2);
+    _device->SetRegisterCacheable(0x14, 2);
 }
 
 MCP23017::~MCP23017() {
 }
 
+int MCP23017::InitDevice(const unsigned short directions, const unsigned short outputs) const {
+    // IOCON bit 7 BANK, bit 5 SEQOP, latches before directions so no pin glitches
+    I2CInitSequence sequence;
+    sequence.AddWrite(0x0A, 0xA0, 0x00);
+    sequence.AddWrite(0x14, static_cast<unsigned char>(outputs & 0xFF));
+    sequence.AddWrite(0x15, static_cast<unsigned char>(outputs >> 8));
+    sequence.AddWrite(0x00, static_cast<unsigned char>(directions & 0xFF));
+    sequence.AddWrite(0x01, static_cast<unsigned char>(directions >> 8));
+    sequence.AddVerify(0x0A, 0xA0, 0x00);
+    sequence.AddVerify(0x14, 0xFF, static_cast<unsigned char>(outputs & 0xFF));
+    sequence.AddVerify(0x15, 0xFF, static_cast<unsigned char>(outputs >> 8));
+    sequence.AddVerify(0x00, 0xFF, static_cast<unsigned char>(directions & 0xFF));
+    sequence.AddVerify(0x01, 0xFF, static_cast<unsigned char>(directions >> 8));
+
+    const auto result = sequence.Run(*_device);
+    if (result < 0) {
+        LOG(ERROR) << "init failed " << result;
+        return result;
+    }
+    return 0;
+}
+
+int MCP23017::CheckSequential() const {
+    // single register reads, IOCON is mirrored to 0x0B in bank 0 only
+    unsigned char iocon[2] = {};
+    I2CTransaction transaction;
+    _device->AddReadByte(transaction, 0x0A, iocon[0]);
+    _device->AddReadByte(transaction, 0x0B, iocon[1]);
+    const auto result = _device->Execute(transaction);
+    if (result < 0) return result;
+    if (iocon[0] != iocon[1] || (iocon[0] & 0xA0) != 0) {
+        LOG(ERROR) << "IOCON 0x" << std::hex << static_cast<int>(iocon[0]) << " BANK or SEQOP set, no sequential register access";
+        return -EINVAL;
+    }
+    return 0;
+}
+
+int MCP23017::ReadConfig(I2CRegisterSnapshot& config) const {
+    auto result = CheckSequential();
+    if (result < 0) return result;
+
+    // IOCON (bit 0 unused), OLAT, the input and interrupt setup, IODIR last
+    config.Clear();
+    config.Set(0x0A, 0x00, 0xFE);
+    config.Set(0x14, 0x00);
+    config.Set(0x15, 0x00);
+    for (unsigned char regAddr = 0x02; regAddr <= 0x09; regAddr++) {
+        config.Set(regAddr, 0x00);
+    }
+    config.Set(0x0C, 0x00);
+    config.Set(0x0D, 0x00);
+    config.Set(0x00, 0x00);
+    config.Set(0x01, 0x00);
+
+    result = config.Capture(*_device);
+    if (result < 0) {
+        LOG(ERROR) << "error read config";
+        return result;
+    }
+    return 0;
+}
+
+int MCP23017::RestoreConfig(const I2CRegisterSnapshot& config) const {
+    // the writes after IOCON must still auto increment
+    unsigned char iocon = 0x00;
+    if (config.Get(0x0A, iocon) && (iocon & 0xA0) != 0) {
+        LOG(ERROR) << "config sets IOCON BANK or SEQOP";
+        return -EINVAL;
+    }
+    auto result = CheckSequential();
+    if (result < 0) return result;
+
+    result = config.Restore(*_device);
+    if (result < 0) {
+        LOG(ERROR) << "restore config failed " << result;
+        return result;
+    }
+    return result;
+}
+
 int MCP23017::ConfigPin(const unsigned char pin, const pin_direction direction) const {
     auto internalPin = pin;
     if (pin > 15) {
@@ -57,26 +142,13 @@ int MCP23017::ConfigPin(const unsigned char pin, const pin_direction direction)
         regAddr = 0x01;
     }
 
-    unsigned char value;
-    auto result = _device->ReadByte(regAddr, value);
-    if(result < 0) {
-        LOG(ERROR) << "error read register";
-        return result;
-    }
-
-    if(direction == pin_direction::in) {
-        value |= static_cast<unsigned char>(1 << internalPin);
-    } else {
-        value &= static_cast<unsigned char>(~(1 << internalPin));
-    }
-
-    result = _device->WriteByte(regAddr, value);
+    const auto result = _device->WriteBit(regAddr, internalPin, direction == pin_direction::in ? 1 : 0);
     if (result < 0) {
         LOG(ERROR) << "error write register";
         return result;
     }
 
-    LOG(DEBUG) << "New Value is " << std::bitset<8>(value);
+    LOG(DEBUG) << "Pin " << static_cast<int>(pin) << " is now " << direction;
 
     return 0;
 }
@@ -94,28 +166,14 @@ int MCP23017::SetPin(const unsigned char pin, const pin_value valuePin) const {
         regAddr = 0x15;
     }
 
-    //Read the register to not change the other pins on this register
-    unsigned char value;
-    auto result = _device->ReadByte(regAddr, value);
-    if (result < 0) {
-        LOG(ERROR) << "error read register";
-        return result;
-    }
-
-    if (valuePin == pin_value::on) {
-        value |= static_cast<unsigned char>(1 << internalPin);
-    }
-    else {
-        value &= static_cast<unsigned char>(~(1 << internalPin));
-    }
-
-    result = _device->WriteByte(regAddr, value);
+    //The shadow of the latch keeps the other pins on this register, no read needed
+    const auto result = _device->WriteBit(regAddr, internalPin, valuePin == pin_value::on ? 1 : 0);
     if (result < 0) {
-        LOG(ERROR) << "error write register" << std::endl;
+        LOG(ERROR) << "error write register";
         return result;
     }
 
-    LOG(DEBUG) << "New Value is " << std::bitset<8>(value).to_string();
+    LOG(DEBUG) << "Pin " << static_cast<int>(pin) << " is now " << valuePin;
 
     return 0;
 }
@@ -151,3 +209,65 @@ int MCP23017::GetPin(unsigned char pin, pin_value& valuePin) const {
     
     return 0;
 }
+
+int MCP23017::WriteOutputs(const unsigned short value) const {
+    // OLATA and OLATB are neighbours (IOCON.BANK = 0) so one auto increment write covers both
+    const unsigned char buffer[2] = { static_cast<unsigned char>(value & 0xFF), static_cast<unsigned char>(value >> 8) };
+    const auto result = _device->WriteBytes(0x14, 2, buffer);
+    if (result < 0) {
+        LOG(ERROR) << "error write register";
+        return result;
+    }
+    return 0;
+}
+
+int MCP23017::ReadOutputs(unsigned short& value) const {
+    unsigned char buffer[2];
+    const auto result = _device->ReadBytes(0x14, 2, buffer);
+    if (result < 0) {
+        LOG(ERROR) << "error read register";
+        return result;
+    }
+    value = static_cast<unsigned short>(buffer[0] | (buffer[1] << 8));
+    return 0;
+}
+
+void MCP23017::SetRequestOptions(const I2CRequestOptions& options) const {
+    _device->SetRequestOptions(options);
+}
+
+void MCP23017::SetInputCacheTtl(const std::chrono::steady_clock::duration ttl) const {
+    _device->SetReadCacheTtl(0x12, 2, ttl);
+}
+
+bool MCP23017::Identify(I2CBus& bus, const unsigned char deviceAddr) {
+    if(deviceAddr < 0x20 || deviceAddr > 0x27) return false;
+
+    // bank 0 with sequential reads wraps after 0x15, so one read returns every register once
+    const int count = 0x16;
+    unsigned char data[count];
+    if(bus.ReadCurrent(deviceAddr, count, data) < 0) return false;
+
+    // a port expander without registers returns the pin state over and over
+    bool periodic = true;
+    for(int i = 2; i < count; i++) {
+        if(data[i] != data[i - 2]) periodic = false;
+    }
+    if(periodic) return false;
+
+    // the pointer is unknown, try every start register
+    for(int start = 0; start < count; start++) {
+        auto reg = [&](const int r) { return data[(r - start + count) % count]; };
+        const unsigned char iocon = reg(0x0A);
+        // IOCON mirrored to 0x0B, BANK and SEQOP 0, bit 0 unused
+        if(iocon != reg(0x0B) || (iocon & 0xA1) != 0) continue;
+        bool match = true;
+        for(int port = 0; port < 2; port++) {
+            // INTF only for enabled pins, output pins read back the latch
+            if((reg(0x0E + port) & ~reg(0x04 + port)) != 0) match = false;
+            if(((reg(0x12 + port) ^ reg(0x14 + port)) & ~reg(0x00 + port)) != 0) match = false;
+        }
+        if(match) return true;
+    }
+    return false;
+}
@@ -24,6 +24,7 @@
 
 #pragma once
 #include "I2CDevice.hpp"
+#include "I2CRegisterSnapshot.hpp"
 
 enum class pin_value;
 enum class pin_direction;
@@ -36,6 +37,12 @@ class I2CBus;
   */
 class MCP23017 {
 	I2CDevice* _device;
+
+	/**
+	 * Read IOCON alone, register reads in one burst need BANK = 0 and SEQOP = 0
+	 * @return 0 ok, -EINVAL other mode, < 0 failed
+	 */
+	int CheckSequential() const;
 public:
 	/**
 	 * Create new MCP23017 Class to Controll the Chip via I²C
@@ -51,6 +58,30 @@ public:
 	MCP23017& operator=(MCP23017&& other) = delete;
 	virtual ~MCP23017();
 
+	/**
+	 * Bring the chip into a known state, after power on or a brown-out:
+	 * IOCON.BANK = 0 and SEQOP = 0 (auto increment), output latches, then
+	 * directions, all in two batched transactions with verify
+	 * @param directions
+	 *    bit 0 - 15 pin 0 - 15, set is input (IODIR), default all inputs
+	 * @param outputs
+	 *    output latch, bit 0 - 7 port A, bit 8 - 15 port B
+	 * @return 0 ok, < 0 failed
+	 */
+	int InitDevice(unsigned short directions = 0xFFFF, unsigned short outputs = 0x0000) const;
+	/**
+	 * Read IOCON, the output latches, IPOL, GPINTEN, DEFVAL, INTCON, GPPU and IODIR
+	 * in one transaction, the order is the one RestoreConfig writes in.
+	 * Refused (-EINVAL) when IOCON.BANK or SEQOP is set, run InitDevice first
+	 */
+	int ReadConfig(I2CRegisterSnapshot& config) const;
+	/**
+	 * Warm restart: write only the registers that differ from config, the output
+	 * latches before the directions, a chip that kept power gets no write.
+	 * Refused (-EINVAL) when the chip or config has IOCON.BANK or SEQOP set
+	 * @return number of written registers, < 0 failed
+	 */
+	int RestoreConfig(const I2CRegisterSnapshot& config) const;
 	/**
 	 * Contig Pin for Output or Input
 	 * @param pin
@@ -68,4 +99,36 @@ public:
 	 */
 	int SetPin(unsigned char pin, const pin_value valuePin) const;
 	int GetPin(unsigned char pin, pin_value& valuePin) const;
+	/**
+	 * Write the output latch of all 16 pins in one transaction
+	 * @param value
+	 *    bit 0 - 7 port A, bit 8 - 15 port B
+	 */
+	int WriteOutputs(unsigned short value) const;
+	/**
+	 * Read the output latch of all 16 pins in one transaction
+	 * @param value
+	 *    bit 0 - 7 port A, bit 8 - 15 port B
+	 */
+	int ReadOutputs(unsigned short& value) const;
+	/**
+	 * Scheduling of the chip access on the bus worker
+	 * @param options
+	 *    see I2CRequestOptions
+	 */
+	void SetRequestOptions(const I2CRequestOptions& options) const;
+	/**
+	 * GetPin reads of GPIOA / GPIOB within ttl come from memory, a write to the chip drops them
+	 * @param ttl
+	 *    0 off (default)
+	 */
+	void SetInputCacheTtl(std::chrono::steady_clock::duration ttl) const;
+
+	/**
+	 * Identify probe for I2CBus::Scan, checks the address range 0x20 - 0x27 and reads all
+	 * 22 registers from the current pointer without writing one (a PCF8574 / PCF8575 there would
+	 * drive its pins with it). Needs IOCON.BANK = 0 and SEQOP = 0, else the chip stays unknown.
+	 * The read clears a pending interrupt like reading GPIO does
+	 */
+	static bool Identify(I2CBus& bus, unsigned char deviceAddr);
 };
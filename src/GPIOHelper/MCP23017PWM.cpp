@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+ /*
+  * File:   MCP23017PWM.cpp
+  * Author: punky
+  *
+  * Created on 19. Oktober 2026
+  */
+
+#ifndef ELPP_DEFAULT_LOGGER
+#   define ELPP_DEFAULT_LOGGER "MCP23017PWM"
+#endif
+#ifndef ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID
+#   define ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID ELPP_DEFAULT_LOGGER
+#endif
+
+#include "../common/easylogging/easylogging++.h"
+#include "../common/exception/ConfigErrorException.hpp"
+#include "../common/exception/NullPointerException.hpp"
+#include "MCP23017PWM.hpp"
+#include "MCP23017.hpp"
+#include "GpioPin.hpp"
+
+int MCP23017PWM::WriteState(const unsigned short state) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto result = _chip->WriteOutputs(state);
+    const auto took = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    // moving average over about 8 writes
+    _writeTime = (_writeTime * 7 + took) / 8;
+    return result;
+}
+
+void MCP23017PWM::PwmTrigger() {
+    el::Helpers::setThreadName("MCP23017PWM");
+    auto periodStart = std::chrono::steady_clock::now();
+    auto lastState = -1;
+    std::array<unsigned int, 16> onSteps{};
+
+    while(_threadRun) {
+        if(_rampMask != 0) {
+            EvaluateRamps(periodStart);
+        }
+
+        const auto steps = _effectiveSteps.load();
+        const auto stepTime = _periodTime / steps;
+        const auto pwmMask = _pwmMask.load();
+        unsigned short state = _staticState & ~pwmMask;
+
+        for(unsigned char pin = 0; pin < 16; pin++) {
+            onSteps[pin] = 0;
+            if((pwmMask & (1 << pin)) == 0) continue;
+            onSteps[pin] = (_duty[pin] * steps + DutyMax / 2) / DutyMax;
+            if(onSteps[pin] > 0) {
+                state |= static_cast<unsigned short>(1 << pin);
+            }
+        }
+
+        // walk only the steps where at least one pin switches off
+        while(true) {
+            if(state != lastState) {
+                WriteState(state);
+                lastState = state;
+            }
+
+            auto nextStep = steps;
+            for(unsigned char pin = 0; pin < 16; pin++) {
+                if((state & (1 << pin)) != 0 && (pwmMask & (1 << pin)) != 0 && onSteps[pin] < nextStep) {
+                    nextStep = onSteps[pin];
+                }
+            }
+            if(nextStep >= steps) break;
+
+            std::this_thread::sleep_until(periodStart + stepTime * nextStep);
+            for(unsigned char pin = 0; pin < 16; pin++) {
+                if((pwmMask & (1 << pin)) != 0 && onSteps[pin] == nextStep) {
+                    state &= static_cast<unsigned short>(~(1 << pin));
+                }
+            }
+        }
+
+        // bound the resolution by the measured bus throughput
+        const auto writeTime = _writeTime.load();
+        auto wantedSteps = _steps;
+        if(writeTime > 0 && _periodTime.count() / writeTime < wantedSteps) {
+            wantedSteps = static_cast<unsigned int>(_periodTime.count() / writeTime);
+            if(wantedSteps < 2) wantedSteps = 2;
+        }
+        if(wantedSteps != steps) {
+            LOG(WARNING) << "write takes " << writeTime << "us, steps per period now " << wantedSteps;
+            _effectiveSteps = wantedSteps;
+        }
+
+        periodStart += _periodTime;
+        const auto now = std::chrono::steady_clock::now();
+        if(now > periodStart + _periodTime) {
+            periodStart = now;
+        }
+        std::this_thread::sleep_until(periodStart);
+    }
+}
+
+void MCP23017PWM::EvaluateRamps(const std::chrono::steady_clock::time_point now) {
+    std::array<pwm_ramp_delegate, 16> finished;
+    {
+        std::lock_guard<std::mutex> lock(_rampMtx);
+        for(unsigned char pin = 0; pin < 16; pin++) {
+            if(!_ramps[pin].IsActive()) continue;
+            _duty[pin] = _ramps[pin].Evaluate(now, finished[pin]);
+            if(!_ramps[pin].IsActive()) {
+                _rampMask &= static_cast<unsigned short>(~(1 << pin));
+            }
+        }
+    }
+    for(auto& callback : finished) {
+        if(callback != nullptr) {
+            callback(true);
+        }
+    }
+}
+
+MCP23017PWM::MCP23017PWM(MCP23017* chip, const unsigned int frq, const unsigned int steps) {
+    el::Loggers::getLogger(ELPP_DEFAULT_LOGGER);
+    LOG(DEBUG) << "Start MCP23017PWM Constructor ... ";
+    if(chip == nullptr) {
+        throw NullPointerException("chip");
+    }
+    if(frq == 0 || frq > 10000) {
+        throw ConfigErrorException("MCP23017PWM frequenz must be 1 - 10000 Hz");
+    }
+    if(steps < 2) {
+        throw ConfigErrorException("MCP23017PWM needs at least 2 steps");
+    }
+
+    _chip = chip;
+    _periodTime = std::chrono::microseconds(1000000 / frq);
+    _steps = steps;
+    _effectiveSteps = steps;
+    _writeTime = 0;
+    _pwmMask = 0;
+    _rampMask = 0;
+    for(auto& duty : _duty) {
+        duty = 0;
+    }
+
+    // keep the pins we do not drive as they are
+    unsigned short outputs = 0;
+    if(_chip->ReadOutputs(outputs) < 0) {
+        throw ConfigErrorException("MCP23017PWM can not read output latch");
+    }
+    _staticState = outputs;
+
+    _threadRun = true;
+    _pwmThread = std::thread(&MCP23017PWM::PwmTrigger, this);
+}
+
+MCP23017PWM::~MCP23017PWM() {
+    LOG(DEBUG) << "Start MCP23017PWM Destructor ... ";
+    _threadRun = false;
+    if (_pwmThread.joinable()) {
+        _pwmThread.join();
+    }
+}
+
+int MCP23017PWM::AddPin(const unsigned char pin, const unsigned int duty) {
+    if (pin > 15) {
+        LOG(ERROR) << "pin must be 0 - 15";
+        return -9;
+    }
+    _duty[pin] = duty > DutyMax ? DutyMax : duty;
+    _pwmMask |= static_cast<unsigned short>(1 << pin);
+    return 0;
+}
+
+int MCP23017PWM::RemovePin(const unsigned char pin, const pin_value valuePin) {
+    if (pin > 15) {
+        LOG(ERROR) << "pin must be 0 - 15";
+        return -9;
+    }
+    if(valuePin == pin_value::on) {
+        _staticState |= static_cast<unsigned short>(1 << pin);
+    } else {
+        _staticState &= static_cast<unsigned short>(~(1 << pin));
+    }
+    _pwmMask &= static_cast<unsigned short>(~(1 << pin));
+    return 0;
+}
+
+int MCP23017PWM::SetDuty(const unsigned char pin, const unsigned int duty) {
+    if (pin > 15) {
+        LOG(ERROR) << "pin must be 0 - 15";
+        return -9;
+    }
+    pwm_ramp_delegate stopped;
+    {
+        std::lock_guard<std::mutex> lock(_rampMtx);
+        stopped = _ramps[pin].Cancel();
+        _rampMask &= static_cast<unsigned short>(~(1 << pin));
+        _duty[pin] = duty > DutyMax ? DutyMax : duty;
+    }
+    if(stopped != nullptr) {
+        stopped(false);
+    }
+    return 0;
+}
+
+int MCP23017PWM::Ramp(const unsigned char pin,
+                      unsigned int duty,
+                      const std::chrono::milliseconds duration,
+                      const pwm_ramp_curve curve,
+                      const pwm_ramp_delegate& callback) {
+    if (pin > 15) {
+        LOG(ERROR) << "pin must be 0 - 15";
+        return -9;
+    }
+    if(duty > DutyMax) {
+        duty = DutyMax;
+    }
+    pwm_ramp_delegate replaced;
+    {
+        std::lock_guard<std::mutex> lock(_rampMtx);
+        replaced = _ramps[pin].Start(_duty[pin], duty, DutyMax, duration, curve, callback);
+        _rampMask |= static_cast<unsigned short>(1 << pin);
+    }
+    if(replaced != nullptr) {
+        replaced(false);
+    }
+    return 0;
+}
+
+unsigned int MCP23017PWM::GetSteps() const {
+    return _effectiveSteps;
+}
+
+std::chrono::microseconds MCP23017PWM::GetWriteTime() const {
+    return std::chrono::microseconds(_writeTime.load());
+}
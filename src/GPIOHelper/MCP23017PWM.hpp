@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+ /*
+  * File:   MCP23017PWM.hpp
+  * Author: punky
+  *
+  * Created on 19. Oktober 2026
+  */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include "PwmRamp.hpp"
+
+class MCP23017;
+enum class pin_value;
+
+/**
+  * \ingroup SystemFunctions
+  *
+  * MCP23017PWM software pwm for the 16 pins of one MCP23017
+  *
+  * The combined state of all pins is written to OLATA/OLATB with one I²C
+  * transaction, and only at the steps where a pin changes, so a period costs
+  * at most 17 writes whatever the number of channels. When a write takes
+  * longer than one step the resolution is lowered until the bus keeps up.
+  */
+class MCP23017PWM {
+    MCP23017* _chip;
+    std::array<std::atomic<unsigned int>, 16> _duty;
+    std::atomic<unsigned short> _pwmMask;
+    std::atomic<unsigned short> _staticState;
+    std::chrono::microseconds _periodTime;
+    unsigned int _steps;
+    std::atomic<unsigned int> _effectiveSteps;
+    std::atomic<long> _writeTime;
+    std::thread _pwmThread;
+    std::atomic<bool> _threadRun;
+    std::array<PwmRamp, 16> _ramps;
+    std::mutex _rampMtx;
+    std::atomic<unsigned short> _rampMask;
+
+    void PwmTrigger();
+    void EvaluateRamps(std::chrono::steady_clock::time_point now);
+    int WriteState(unsigned short state);
+public:
+    /**
+     * Full scale duty value (100 %)
+     */
+    static constexpr unsigned int DutyMax = 0xFFFF;
+
+    /**
+     * Create new MCP23017PWM Thread
+     * @param chip
+     *    the expander, must be configured for output on the pwm pins
+     * @param frq
+     *    The Freqenz in Hz
+     * @param steps
+     *    duty resolution per period, lowered if the bus is to slow
+     */
+    explicit MCP23017PWM(MCP23017* chip, unsigned int frq, unsigned int steps = 64);
+    MCP23017PWM(const MCP23017PWM& orig) = delete;
+    MCP23017PWM(MCP23017PWM&& other) = delete;
+    MCP23017PWM& operator=(const MCP23017PWM& other) = delete;
+    MCP23017PWM& operator=(MCP23017PWM&& other) = delete;
+    virtual ~MCP23017PWM();
+
+    /**
+     * Let the pwm thread drive the pin
+     * @param pin
+     *    the pin 0 - 15
+     * @param duty
+     *    duty 0 - DutyMax (0.0 - 100.0 %)
+     */
+    int AddPin(unsigned char pin, unsigned int duty = 0);
+    /**
+     * Stop driving the pin and leave it at a fixed level
+     * @param pin
+     *    the pin 0 - 15
+     * @param valuePin
+     *    see pin_value
+     */
+    int RemovePin(unsigned char pin, pin_value valuePin);
+    /**
+     * Change Duty, takes effect at the next period, a running ramp is stopped
+     * @param pin
+     *    the pin 0 - 15
+     * @param duty
+     *    duty 0 - DutyMax (0.0 - 100.0 %)
+     */
+    int SetDuty(unsigned char pin, unsigned int duty);
+    /**
+     * Move the duty of the pin to target within duration, updated every period
+     * @param pin
+     *    the pin 0 - 15
+     * @param duty
+     *    target duty 0 - DutyMax (0.0 - 100.0 %)
+     * @param curve
+     *    see pwm_ramp_curve
+     * @param callback
+     *    called from the pwm thread when the ramp ends (true), keep it short,
+     *    a ramp replaced by SetDuty / Ramp gets false on the caller thread
+     */
+    int Ramp(unsigned char pin,
+             unsigned int duty,
+             std::chrono::milliseconds duration,
+             pwm_ramp_curve curve = pwm_ramp_curve::linear,
+             const pwm_ramp_delegate& callback = nullptr);
+    unsigned int GetSteps() const;
+    /**
+     * Measured average time of one output write
+     */
+    std::chrono::microseconds GetWriteTime() const;
+};
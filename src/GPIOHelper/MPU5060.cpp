@@ -13,6 +13,7 @@
 #include <cmath>
 #include "../common/easylogging/easylogging++.h"
 #include "../common/exception/ConfigErrorException.hpp"
+#include "I2CInitSequence.hpp"
 
 #define RAD_2_DEG 57.29578 // 180 / M_PI [deg/rad]
 #define DEFAULT_GYRO_COEFF 0.98
@@ -50,6 +51,8 @@
 #define MPU6050_RA_PWR_MGMT_2 0x6C
 
 #define MPU6050_PWR1_SLEEP_BIT 6
+#define MPU6050_PWR1_CLKSEL_BIT 2
+#define MPU6050_PWR1_CLKSEL_LENGTH 3
 
 #define MPU6050_RA_ACCEL_XOUT_H 0x3B
 #define MPU6050_RA_ACCEL_XOUT_L 0x3C
@@ -74,6 +77,25 @@ MPU5060::MPU5060(I2CBus* bus, unsigned char deviceAddr)
 {
     el::Loggers::getLogger(ELPP_DEFAULT_LOGGER);
     _device = new I2CDevice(bus, deviceAddr);
+    ConfigDevice();
+}
+
+MPU5060::MPU5060(TCA9548A* mux, const unsigned char channel, const unsigned char deviceAddr)
+    : _dpsPerDigit(0.0), _rangePerDigit(0.0), _upsideDownMounting(false), _filterGyroCoef(DEFAULT_GYRO_COEFF), _lastTime(timer::now()), _angleX(0.0),_angleY(0.0),_angleZ(0.0)
+{
+    el::Loggers::getLogger(ELPP_DEFAULT_LOGGER);
+    _device = new I2CDevice(mux, channel, deviceAddr);
+    ConfigDevice();
+}
+
+void MPU5060::ConfigDevice()
+{
+    // samples are time critical, do not let slow expander polling delay them
+    I2CRequestOptions options;
+    options.priority = i2c_priority::high;
+    _device->SetRequestOptions(options);
+    _device->SetRegisterCacheable(MPU6050_RA_GYRO_CONFIG, 2);
+    _device->SetRegisterCacheable(MPU6050_RA_PWR_MGMT_1);
 }
 
 MPU5060::~MPU5060()
@@ -82,25 +104,30 @@ MPU5060::~MPU5060()
 
 bool MPU5060::InitDevice()
 {
-    unsigned char value = 0x00;
-    const auto result = _device->ReadBits(MPU6050_RA_WHO_AM_I, MPU6050_WHO_AM_I_BIT, MPU6050_WHO_AM_I_LENGTH, value);
-
-    if(result < 0 || value != 0x34) {
-        LOG(ERROR) << "no mpu6050 or i2c read error result " << result << " value " << value;
+    // WHO_AM_I bits 6..1 are 0x34, PWR_MGMT_1 clock source bits 2..0 and sleep bit 6, range bits 4..3
+    I2CInitSequence sequence;
+    sequence.AddVerify(MPU6050_RA_WHO_AM_I, 0x7E, 0x34 << 1);
+    sequence.AddWrite(MPU6050_RA_PWR_MGMT_1, 0x47, MPU6050_CLOCK_PLL_XGYRO);
+    sequence.AddWrite(MPU6050_RA_GYRO_CONFIG, 0x18, MPU6050_GYRO_FS_250 << 3);
+    sequence.AddWrite(MPU6050_RA_ACCEL_CONFIG, 0x18, MPU6050_ACCEL_FS_2 << 3);
+    sequence.AddVerify(MPU6050_RA_PWR_MGMT_1, 0x47, MPU6050_CLOCK_PLL_XGYRO);
+    sequence.AddVerify(MPU6050_RA_GYRO_CONFIG, 0x18, MPU6050_GYRO_FS_250 << 3);
+    sequence.AddVerify(MPU6050_RA_ACCEL_CONFIG, 0x18, MPU6050_ACCEL_FS_2 << 3);
+
+    const auto result = sequence.Run(*_device);
+    if(result < 0) {
+        LOG(ERROR) << "no mpu6050 or i2c error result " << result;
         return false;
     }
 
-    SetClockSource(MPU6050_CLOCK_PLL_XGYRO);
-    SetFullScaleGyroRange(MPU6050_GYRO_FS_250);
-    SetFullScaleAccelRange(MPU6050_ACCEL_FS_2);
-    SetSleepEnabled(false);
-
+    UpdateGyroScale(MPU6050_GYRO_FS_250);
+    UpdateAccelScale(MPU6050_ACCEL_FS_2);
     return true;
 }
 
 void MPU5060::SetClockSource(const unsigned char source)
 {
-    _device->WriteBits(MPU6050_RA_WHO_AM_I, MPU6050_WHO_AM_I_BIT, MPU6050_WHO_AM_I_LENGTH, source);
+    _device->WriteBits(MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CLKSEL_BIT, MPU6050_PWR1_CLKSEL_LENGTH, source);
 }
 
 /** Set full-scale gyroscope range.
@@ -120,6 +147,11 @@ void MPU5060::SetFullScaleGyroRange(const unsigned char range)
         return;
     }
 
+    UpdateGyroScale(range);
+}
+
+void MPU5060::UpdateGyroScale(const unsigned char range)
+{
     _dpsPerDigit = 1.0f;
     switch(range) {
     case MPU6050_GYRO_FS_250:
@@ -157,6 +189,11 @@ void MPU5060::SetFullScaleAccelRange(const unsigned char range)
         return;
     }
 
+    UpdateAccelScale(range);
+}
+
+void MPU5060::UpdateAccelScale(const unsigned char range)
+{
     _rangePerDigit = 0.0f;
     switch(range) {
     case MPU6050_ACCEL_FS_2:
@@ -275,4 +312,24 @@ void MPU5060::GetAngels(double* angleAccX, double* angleAccY, double* angleX, do
     *angleX = _angleX;
     *angleY = _angleY;
     *angleZ = _angleZ;
-}
\ No newline at end of file
+}
+
+void MPU5060::SetRequestOptions(const I2CRequestOptions& options)
+{
+    _device->SetRequestOptions(options);
+}
+
+void MPU5060::SetTempCacheTtl(const std::chrono::steady_clock::duration ttl)
+{
+    _device->SetReadCacheTtl(MPU6050_REG_TEMP_OUT_H, 2, ttl);
+}
+
+bool MPU5060::Identify(I2CBus& bus, const unsigned char deviceAddr)
+{
+    if(deviceAddr != 0x68 && deviceAddr != 0x69) return false;
+
+    unsigned char value = 0x00;
+    if(bus.ReadByte(deviceAddr, MPU6050_RA_WHO_AM_I, value) < 0) return false;
+    // bit 6 - 1, without the AD0 bit
+    return (value & 0x7E) == 0x68;
+}
@@ -7,6 +7,7 @@ typedef std::chrono::system_clock timer;
 enum class pin_value;
 enum class pin_direction;
 class I2CBus;
+class TCA9548A;
 
 /**
   * \ingroup SystemFunctions
@@ -20,6 +21,10 @@ class MPU5060 {
 	double _filterGyroCoef;
 	timer::time_point _lastTime;
 	double _angleX, _angleY, _angleZ;
+
+	void ConfigDevice();
+	void UpdateGyroScale(unsigned char range);
+	void UpdateAccelScale(unsigned char range);
 public:
 	/**
 	 * Create new MPU5060 Class to Control the Chip via I²C
@@ -29,12 +34,26 @@ public:
 	 *    The device Address
 	 */
 	explicit MPU5060(I2CBus* bus, unsigned char deviceAddr);
+	/**
+	 * Create new MPU5060 behind a multiplexer
+	 * @param mux
+	 *    see TCA9548A
+	 * @param channel
+	 *    the mux channel 0 - 7
+	 * @param deviceAddr
+	 *    The device Address
+	 */
+	MPU5060(TCA9548A* mux, unsigned char channel, unsigned char deviceAddr);
     MPU5060(const MPU5060& orig) = delete;
 	MPU5060(MPU5060&& other) = delete;
 	MPU5060& operator=(const MPU5060& other) = delete;
 	MPU5060& operator=(MPU5060&& other) = delete;
 	virtual ~MPU5060();
 
+	/**
+	 * Check WHO_AM_I, set the clock source, gyro / accel range and wake up
+	 * in two batched transactions with verify, see I2CInitSequence
+	 */
     bool InitDevice();
 	void SetClockSource(const unsigned char source);
 	void SetFullScaleGyroRange(const unsigned char range);
@@ -44,4 +63,21 @@ public:
 	void GetMotion6(double* accX, double* accY, double* accZ, double* gyroX, double* gyroY, double* gyroZ, double* tempC);
 	double GetTemp();
 	void GetAngels(double* angleAccX, double* angleAccY, double* angleX, double* angleY, double* angleZ);
+	/**
+	 * Scheduling of the sensor access on the bus worker, default is high priority
+	 * @param options
+	 *    see I2CRequestOptions
+	 */
+	void SetRequestOptions(const I2CRequestOptions& options);
+	/**
+	 * GetTemp reads within ttl come from memory, the temperature changes slowly
+	 * @param ttl
+	 *    0 off (default)
+	 */
+	void SetTempCacheTtl(std::chrono::steady_clock::duration ttl);
+
+	/**
+	 * Identify probe for I2CBus::Scan, reads WHO_AM_I on 0x68 and 0x69
+	 */
+	static bool Identify(I2CBus& bus, unsigned char deviceAddr);
 };
\ No newline at end of file
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+ /*
+  * File:   PwmRamp.cpp
+  * Author: punky
+  *
+  * Created on 19. Oktober 2026
+  */
+
+#include "PwmRamp.hpp"
+#include <algorithm>
+#include <cmath>
+
+#define PWM_RAMP_GAMMA 2.2
+
+pwm_ramp_delegate PwmRamp::Start(const unsigned int startDuty,
+                                 const unsigned int targetDuty,
+                                 const unsigned int dutyMax,
+                                 const std::chrono::microseconds duration,
+                                 const pwm_ramp_curve curve,
+                                 const pwm_ramp_delegate& callback) {
+    auto replaced = Cancel();
+    _startDuty = startDuty;
+    _targetDuty = targetDuty;
+    _dutyMax = dutyMax;
+    _start = std::chrono::steady_clock::now();
+    _duration = duration;
+    _curve = curve;
+    _callback = callback;
+    _active = true;
+    return replaced;
+}
+
+pwm_ramp_delegate PwmRamp::Cancel() {
+    pwm_ramp_delegate callback;
+    if(_active) {
+        callback.swap(_callback);
+    }
+    _active = false;
+    return callback;
+}
+
+bool PwmRamp::IsActive() const {
+    return _active;
+}
+
+unsigned int PwmRamp::Evaluate(const std::chrono::steady_clock::time_point now, pwm_ramp_delegate& finished) {
+    if(!_active) {
+        return _targetDuty;
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - _start);
+    if(elapsed >= _duration) {
+        _active = false;
+        finished.swap(_callback);
+        return _targetDuty;
+    }
+
+    // the pwm thread passes the scheduled period start, it can be before the ramp start
+    const auto progress = std::min(std::max(static_cast<double>(elapsed.count()) / static_cast<double>(_duration.count()), 0.0), 1.0);
+    const auto start = static_cast<double>(_startDuty);
+    const auto target = static_cast<double>(_targetDuty);
+    double duty;
+
+    switch(_curve) {
+    case pwm_ramp_curve::gamma: {
+        // interpolate in perceived brightness and convert back
+        const auto max = static_cast<double>(_dutyMax);
+        const auto startLight = std::pow(start / max, 1.0 / PWM_RAMP_GAMMA);
+        const auto targetLight = std::pow(target / max, 1.0 / PWM_RAMP_GAMMA);
+        duty = std::pow(startLight + (targetLight - startLight) * progress, PWM_RAMP_GAMMA) * max;
+        break;
+    }
+    case pwm_ramp_curve::s_curve:
+        duty = start + (target - start) * progress * progress * (3.0 - 2.0 * progress);
+        break;
+    default:
+        duty = start + (target - start) * progress;
+        break;
+    }
+
+    return static_cast<unsigned int>(std::min(std::max(duty, 0.0), static_cast<double>(_dutyMax)) + 0.5);
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+ /*
+  * File:   PwmRamp.hpp
+  * Author: punky
+  *
+  * Created on 19. Oktober 2026
+  */
+
+#pragma once
+#include <chrono>
+#include <functional>
+
+enum class pwm_ramp_curve : int {
+    linear,
+    gamma,  // linear for the eye, use for LED fades
+    s_curve // smooth start and stop, use for motors
+};
+
+/**
+ * CallBack delegate for the end of a ramp, called from the pwm thread with true,
+ * a ramp replaced by ChangeDuty / SetDuty / Ramp gets false on the caller thread
+ * @param finished
+ *    true target reached, false replaced by a new ramp or duty
+ */
+typedef std::function<void(bool finished)> pwm_ramp_delegate;
+
+/**
+  * \ingroup SystemFunctions
+  *
+  * PwmRamp duty ramp evaluated by a pwm thread at its period boundaries
+  */
+class PwmRamp {
+    unsigned int _startDuty{};
+    unsigned int _targetDuty{};
+    unsigned int _dutyMax{};
+    std::chrono::steady_clock::time_point _start;
+    std::chrono::microseconds _duration{};
+    pwm_ramp_curve _curve{};
+    pwm_ramp_delegate _callback;
+    bool _active{};
+public:
+    /**
+     * Begin a new ramp, a running one is replaced
+     * @return callback of the replaced ramp, call it with false
+     */
+    pwm_ramp_delegate Start(unsigned int startDuty,
+                            unsigned int targetDuty,
+                            unsigned int dutyMax,
+                            std::chrono::microseconds duration,
+                            pwm_ramp_curve curve,
+                            const pwm_ramp_delegate& callback);
+    /**
+     * Stop the ramp at the current duty
+     * @return callback of the stopped ramp, call it with false
+     */
+    pwm_ramp_delegate Cancel();
+    bool IsActive() const;
+    /**
+     * Duty for the period starting now
+     * @param finished
+     *    set to the callback when the target is reached, call it with true
+     */
+    unsigned int Evaluate(std::chrono::steady_clock::time_point now, pwm_ramp_delegate& finished);
+};
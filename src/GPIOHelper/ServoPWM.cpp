@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+ /*
+  * File:   ServoPWM.cpp
+  * Author: punky
+  *
+  * Created on 19. Oktober 2026
+  */
+
+#ifndef ELPP_DEFAULT_LOGGER
+#   define ELPP_DEFAULT_LOGGER "ServoPWM"
+#endif
+#ifndef ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID
+#   define ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID ELPP_DEFAULT_LOGGER
+#endif
+
+#include "../common/easylogging/easylogging++.h"
+#include "../common/exception/ConfigErrorException.hpp"
+#include "../common/exception/NullPointerException.hpp"
+#include "ServoPWM.hpp"
+#include "GpioPin.hpp"
+
+void ServoPWM::ServoTrigger() {
+    el::Helpers::setThreadName("ServoPWM");
+    auto frameStart = std::chrono::steady_clock::now();
+    const auto slots = static_cast<int>(_frameTime.count() / SlotTime);
+
+    while(_threadRun) {
+        for(auto slot = 0; slot < slots && _threadRun; slot++) {
+            const auto channel = GetChannel(slot);
+            if(channel == nullptr) break;
+
+            const auto pulse = channel->pulse.load(std::memory_order_relaxed);
+            if(pulse == 0) continue;
+
+            const auto slotStart = frameStart + std::chrono::microseconds(SlotTime * slot);
+            std::this_thread::sleep_until(slotStart);
+            *channel->pin << 1;
+            std::this_thread::sleep_until(slotStart + std::chrono::microseconds(pulse));
+            *channel->pin << 0;
+        }
+
+        frameStart += _frameTime;
+        const auto now = std::chrono::steady_clock::now();
+        if(now > frameStart + _frameTime) {
+            frameStart = now;
+        }
+        std::this_thread::sleep_until(frameStart);
+    }
+}
+
+ServoPWM::Channel* ServoPWM::GetChannel(const int channel) {
+    std::lock_guard<std::mutex> lock(_mtx);
+    if(channel < 0 || channel >= static_cast<int>(_channels.size())) {
+        return nullptr;
+    }
+    return _channels[channel].get();
+}
+
+ServoPWM::ServoPWM(const unsigned int frameTime) {
+    el::Loggers::getLogger(ELPP_DEFAULT_LOGGER);
+    LOG(DEBUG) << "Start ServoPWM Constructor ... ";
+    if(frameTime * 1000 < SlotTime) {
+        throw ConfigErrorException("ServoPWM frame must hold at least one slot");
+    }
+    _frameTime = std::chrono::milliseconds(frameTime);
+    LOG(DEBUG) << "frame has " << _frameTime.count() / SlotTime << " slots";
+    _threadRun = true;
+    _servoThread = std::thread(&ServoPWM::ServoTrigger, this);
+}
+
+ServoPWM::~ServoPWM() {
+    LOG(DEBUG) << "Start ServoPWM Destructor ... ";
+    _threadRun = false;
+    if (_servoThread.joinable()) {
+        _servoThread.join();
+    }
+}
+
+int ServoPWM::AddServo(GpioPin* pin, const servo_calibration& calibration) {
+    if(pin == nullptr) {
+        throw NullPointerException("pin");
+    }
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    if(static_cast<long>(_channels.size()) >= _frameTime.count() / SlotTime) {
+        LOG(ERROR) << "no free slot in frame";
+        return -9;
+    }
+
+    auto channel = std::make_unique<Channel>();
+    channel->pin = pin;
+    channel->calibration = calibration;
+    channel->pulse = 0;
+    _channels.push_back(std::move(channel));
+    return static_cast<int>(_channels.size() - 1);
+}
+
+int ServoPWM::SetCalibration(const int channel, const servo_calibration& calibration) {
+    std::lock_guard<std::mutex> lock(_mtx);
+    if(channel < 0 || channel >= static_cast<int>(_channels.size())) {
+        LOG(ERROR) << "channel " << channel << " not found";
+        return -9;
+    }
+    _channels[channel]->calibration = calibration;
+    return 0;
+}
+
+int ServoPWM::SetAngle(const int channel, double angle) {
+    servo_calibration calibration;
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        if(channel < 0 || channel >= static_cast<int>(_channels.size())) {
+            LOG(ERROR) << "channel " << channel << " not found";
+            return -9;
+        }
+        calibration = _channels[channel]->calibration;
+    }
+
+    if(calibration.maxAngle <= calibration.minAngle) {
+        LOG(ERROR) << "calibration of channel " << channel << " has no angle range";
+        return -9;
+    }
+    if(angle < calibration.minAngle) angle = calibration.minAngle;
+    if(angle > calibration.maxAngle) angle = calibration.maxAngle;
+
+    const auto span = static_cast<double>(calibration.maxPulse) - static_cast<double>(calibration.minPulse);
+    auto pulse = calibration.minPulse + span * (angle - calibration.minAngle) / (calibration.maxAngle - calibration.minAngle);
+    pulse += calibration.trim;
+    if(pulse < 1) pulse = 1;
+
+    return SetPulse(channel, static_cast<unsigned int>(pulse + 0.5));
+}
+
+int ServoPWM::SetPulse(const int channel, unsigned int pulse) {
+    const auto servo = GetChannel(channel);
+    if(servo == nullptr) {
+        LOG(ERROR) << "channel " << channel << " not found";
+        return -9;
+    }
+    if(pulse > SlotTime) {
+        pulse = SlotTime;
+    }
+    servo->pulse.store(pulse, std::memory_order_relaxed);
+    return 0;
+}
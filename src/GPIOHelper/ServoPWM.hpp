@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+ /*
+  * File:   ServoPWM.hpp
+  * Author: punky
+  *
+  * Created on 19. Oktober 2026
+  */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class GpioPin;
+
+/**
+ * Maps an angle to a servo pulse
+ */
+struct servo_calibration {
+    unsigned int minPulse = 1000; // microsecond at minAngle
+    unsigned int maxPulse = 2000; // microsecond at maxAngle
+    double minAngle = 0.0;
+    double maxAngle = 180.0;
+    int trim = 0; // microsecond added to every pulse
+};
+
+/**
+  * \ingroup SystemFunctions
+  *
+  * ServoPWM drives many RC servos from one thread
+  *
+  * Every servo owns a fixed slot of the frame and the pulses are sent one
+  * after the other, so only one servo starts moving at a time and the thread
+  * wakes twice per servo instead of every servo having its own pwm thread.
+  */
+class ServoPWM {
+    struct Channel {
+        GpioPin* pin;
+        servo_calibration calibration;
+        std::atomic<unsigned int> pulse;
+    };
+
+    std::vector<std::unique_ptr<Channel>> _channels;
+    std::mutex _mtx;
+    std::chrono::microseconds _frameTime;
+    std::thread _servoThread;
+    std::atomic<bool> _threadRun;
+
+    void ServoTrigger();
+    Channel* GetChannel(int channel);
+public:
+    /**
+     * Time reserved for one servo pulse
+     */
+    static constexpr unsigned int SlotTime = 2500;
+
+    /**
+     * Create new ServoPWM Thread
+     * @param frameTime
+     *    the servo period in millisecond, frameTime / 2.5 ms servos fit in
+     */
+    explicit ServoPWM(unsigned int frameTime = 20);
+    ServoPWM(const ServoPWM& orig) = delete;
+    ServoPWM(ServoPWM&& other) = delete;
+    ServoPWM& operator=(const ServoPWM& other) = delete;
+    ServoPWM& operator=(ServoPWM&& other) = delete;
+    virtual ~ServoPWM();
+
+    /**
+     * Add a servo, no pulse is sent until an angle or pulse is set
+     * @param pin
+     *    the pin will be controlled by the servo thread
+     * @param calibration
+     *    see servo_calibration
+     * @return channel number, < 0 all slots in use
+     */
+    int AddServo(GpioPin* pin, const servo_calibration& calibration = servo_calibration());
+    int SetCalibration(int channel, const servo_calibration& calibration);
+    /**
+     * Move the servo, takes effect at the next frame
+     * @param angle
+     *    limited to the calibration range
+     */
+    int SetAngle(int channel, double angle);
+    /**
+     * Set the raw pulse, 0 stops the pulses
+     * @param pulse
+     *    microsecond up to SlotTime
+     */
+    int SetPulse(int channel, unsigned int pulse);
+};
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+ /*
+  * File:   SigmaDeltaPWM.cpp
+  * Author: punky
+  *
+  * Created on 19. Oktober 2026
+  */
+
+#ifndef ELPP_DEFAULT_LOGGER
+#   define ELPP_DEFAULT_LOGGER "SigmaDeltaPWM"
+#endif
+#ifndef ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID
+#   define ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID ELPP_DEFAULT_LOGGER
+#endif
+
+#include "../common/easylogging/easylogging++.h"
+#include "../common/exception/ConfigErrorException.hpp"
+#include "../common/exception/NullPointerException.hpp"
+#include "SigmaDeltaPWM.hpp"
+#include "GpioPin.hpp"
+
+void SigmaDeltaPWM::PdmTrigger() {
+    el::Helpers::setThreadName("SigmaDeltaPWM");
+    auto tickStart = std::chrono::steady_clock::now();
+
+    while(_threadRun) {
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            for(auto& channel : _channels) {
+                channel->accumulator += channel->level.load(std::memory_order_relaxed);
+                auto bit = 0;
+                // modulus LevelMax, so level LevelMax gives a steady high and 0 a steady low
+                if(channel->accumulator >= LevelMax) {
+                    channel->accumulator -= LevelMax;
+                    bit = 1;
+                }
+                if(bit != channel->pinState) {
+                    *channel->pin << bit;
+                    channel->pinState = bit;
+                }
+            }
+        }
+
+        tickStart += _tickTime;
+        const auto now = std::chrono::steady_clock::now();
+        if(now > tickStart + _tickTime) {
+            // more than one tick behind, the density stays right so just skip the lost ticks
+            tickStart = now;
+        }
+        std::this_thread::sleep_until(tickStart);
+    }
+}
+
+SigmaDeltaPWM::SigmaDeltaPWM(const unsigned int tickRate) {
+    el::Loggers::getLogger(ELPP_DEFAULT_LOGGER);
+    LOG(DEBUG) << "Start SigmaDeltaPWM Constructor ... ";
+    if(tickRate == 0 || tickRate > 1000000) {
+        throw ConfigErrorException("SigmaDeltaPWM tick rate must be 1 - 1000000 Hz");
+    }
+    _tickTime = std::chrono::microseconds(1000000 / tickRate);
+    LOG(DEBUG) << "tickTime is " << _tickTime.count();
+    _threadRun = true;
+    _pdmThread = std::thread(&SigmaDeltaPWM::PdmTrigger, this);
+}
+
+SigmaDeltaPWM::~SigmaDeltaPWM() {
+    LOG(DEBUG) << "Start SigmaDeltaPWM Destructor ... ";
+    _threadRun = false;
+    if (_pdmThread.joinable()) {
+        _pdmThread.join();
+    }
+}
+
+int SigmaDeltaPWM::AddPin(GpioPin* pin, const unsigned int level) {
+    if(pin == nullptr) {
+        throw NullPointerException("pin");
+    }
+
+    auto channel = std::make_unique<Channel>();
+    channel->pin = pin;
+    channel->level = level > LevelMax ? LevelMax : level;
+    // start half way so the first pulse is centred in the window
+    channel->accumulator = LevelMax / 2;
+    channel->pinState = -1;
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    _channels.push_back(std::move(channel));
+    return static_cast<int>(_channels.size() - 1);
+}
+
+int SigmaDeltaPWM::SetLevel(const int channel, const unsigned int level) {
+    std::lock_guard<std::mutex> lock(_mtx);
+    if(channel < 0 || channel >= static_cast<int>(_channels.size())) {
+        LOG(ERROR) << "channel " << channel << " not found";
+        return -9;
+    }
+    _channels[channel]->level.store(level > LevelMax ? LevelMax : level, std::memory_order_relaxed);
+    return 0;
+}
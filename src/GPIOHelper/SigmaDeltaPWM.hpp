@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+ /*
+  * File:   SigmaDeltaPWM.hpp
+  * Author: punky
+  *
+  * Created on 19. Oktober 2026
+  */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class GpioPin;
+
+/**
+  * \ingroup SystemFunctions
+  *
+  * SigmaDeltaPWM (pulse density modulation)
+  *
+  * One thread drives any number of pins at a fixed tick rate. Every tick the
+  * level of each channel is added to an error accumulator and the pin is high
+  * for this tick when the accumulator overflows. The on time is spread over
+  * the whole window instead of one block per period, so an LED flickers less
+  * and an RC filter needs a smaller capacitor at the same tick rate.
+  */
+class SigmaDeltaPWM {
+    struct Channel {
+        GpioPin* pin;
+        std::atomic<unsigned int> level;
+        unsigned int accumulator;
+        int pinState;
+    };
+
+    std::vector<std::unique_ptr<Channel>> _channels;
+    std::mutex _mtx;
+    std::chrono::microseconds _tickTime;
+    std::thread _pdmThread;
+    std::atomic<bool> _threadRun;
+
+    void PdmTrigger();
+public:
+    /**
+     * Full scale level (100 %)
+     */
+    static constexpr unsigned int LevelMax = 0xFFFF;
+
+    /**
+     * Create new SigmaDeltaPWM Thread
+     * @param tickRate
+     *    the output bits per second for every pin in Hz
+     */
+    explicit SigmaDeltaPWM(unsigned int tickRate);
+    SigmaDeltaPWM(const SigmaDeltaPWM& orig) = delete;
+    SigmaDeltaPWM(SigmaDeltaPWM&& other) = delete;
+    SigmaDeltaPWM& operator=(const SigmaDeltaPWM& other) = delete;
+    SigmaDeltaPWM& operator=(SigmaDeltaPWM&& other) = delete;
+    virtual ~SigmaDeltaPWM();
+
+    /**
+     * Add a pin to the tick
+     * @param pin
+     *    the pin will be controlled by the pdm thread
+     * @param level
+     *    level 0 - LevelMax (0.0 - 100.0 %)
+     * @return channel number, < 0 failed
+     */
+    int AddPin(GpioPin* pin, unsigned int level = 0);
+    /**
+     * Change the level of a channel, takes effect at the next tick
+     * @param channel
+     *    the number from AddPin
+     * @param level
+     *    level 0 - LevelMax (0.0 - 100.0 %)
+     */
+    int SetLevel(int channel, unsigned int level);
+};
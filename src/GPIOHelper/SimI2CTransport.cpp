@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   SimI2CTransport.cpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#include "SimI2CTransport.hpp"
+#include <linux/i2c.h>
+#include <algorithm>
+#include <cerrno>
+#include <thread>
+#include "I2CTiming.hpp"
+#include "SimTCA9548A.hpp"
+
+unsigned char SimI2CDevice::ReadRegister(const unsigned char regAddr)
+{
+    return _registers[regAddr];
+}
+
+void SimI2CDevice::WriteRegister(const unsigned char regAddr, const unsigned char value)
+{
+    _registers[regAddr] = value;
+}
+
+unsigned char SimI2CDevice::NextRegister(const unsigned char regAddr) const
+{
+    return static_cast<unsigned char>(regAddr + 1);
+}
+
+void SimI2CDevice::Write(const unsigned char* data, const unsigned short length)
+{
+    if(length == 0) return;
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    _pointer = data[0];
+    for(unsigned short index = 1; index < length; index++) {
+        WriteRegister(_pointer, data[index]);
+        _pointer = NextRegister(_pointer);
+    }
+}
+
+void SimI2CDevice::Read(unsigned char* data, const unsigned short length)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    for(unsigned short index = 0; index < length; index++) {
+        data[index] = ReadRegister(_pointer);
+        _pointer = NextRegister(_pointer);
+    }
+}
+
+void SimI2CDevice::Reset()
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    _registers.fill(0x00);
+    _pointer = 0;
+}
+
+unsigned char SimI2CDevice::Peek(const unsigned char regAddr) const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _registers[regAddr];
+}
+
+void SimI2CDevice::Poke(const unsigned char regAddr, const unsigned char value)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    _registers[regAddr] = value;
+}
+
+SimI2CTransport::SimI2CTransport(const unsigned int clockRate, const std::chrono::microseconds overhead)
+    : _clockRate(clockRate), _overhead(overhead), _simulateLatency(true), _functionality(I2C_FUNC_I2C | I2C_FUNC_SMBUS_EMUL)
+{
+}
+
+void SimI2CTransport::AddDevice(const unsigned char deviceAddr, const std::shared_ptr<SimI2CDevice>& device)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    _devices[deviceAddr] = device;
+    const auto mux = std::dynamic_pointer_cast<SimTCA9548A>(device);
+    if(mux != nullptr) {
+        _muxes[deviceAddr] = mux;
+    }
+}
+
+void SimI2CTransport::RemoveDevice(const unsigned char deviceAddr)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    _devices.erase(deviceAddr);
+    _muxes.erase(deviceAddr);
+}
+
+std::shared_ptr<SimI2CDevice> SimI2CTransport::FindDevice(const unsigned char deviceAddr) const
+{
+    const auto device = _devices.find(deviceAddr);
+    if(device != _devices.end()) return device->second;
+    for(const auto& mux : _muxes) {
+        auto behind = mux.second->FindDevice(deviceAddr);
+        if(behind != nullptr) return behind;
+    }
+    return nullptr;
+}
+
+void SimI2CTransport::SetLatencySimulation(const bool enabled)
+{
+    _simulateLatency = enabled;
+}
+
+void SimI2CTransport::SetFunctionality(const unsigned long functionality)
+{
+    _functionality = functionality;
+}
+
+void SimI2CTransport::WaitWireTime(const std::chrono::steady_clock::time_point start, const i2c_msg* messages, const unsigned int count) const
+{
+    if(!_simulateLatency) return;
+
+    const auto end = start + _overhead + I2CTiming::WireTime(messages, count, _clockRate);
+    // sleep is to coarse for single transfers, spin the last part
+    if(end - std::chrono::steady_clock::now() > std::chrono::microseconds(200)) {
+        std::this_thread::sleep_until(end - std::chrono::microseconds(100));
+    }
+    while(std::chrono::steady_clock::now() < end) {
+        std::this_thread::yield();
+    }
+}
+
+int SimI2CTransport::Transfer(i2c_msg* messages, const unsigned int count)
+{
+    if(!(_functionality & I2C_FUNC_I2C)) return -EOPNOTSUPP;
+    return Run(messages, count);
+}
+
+int SimI2CTransport::Run(i2c_msg* messages, const unsigned int count)
+{
+    const auto start = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(_mtx);
+
+    for(unsigned int index = 0; index < count; index++) {
+        auto& message = messages[index];
+        const auto device = FindDevice(static_cast<unsigned char>(message.addr));
+        if(device == nullptr) {
+            // no ack for the address, the adapter stops here
+            WaitWireTime(start, messages, index + 1);
+            return -ENXIO;
+        }
+        if(message.flags & I2C_M_RD) {
+            device->Read(message.buf, message.len);
+        } else {
+            device->Write(message.buf, message.len);
+        }
+    }
+
+    WaitWireTime(start, messages, count);
+    return static_cast<int>(count);
+}
+
+int SimI2CTransport::SmbusReadBlock(const unsigned char deviceAddr,
+                                    const unsigned char regAddr,
+                                    unsigned char* value,
+                                    const unsigned char length)
+{
+    if(!(_functionality & I2C_FUNC_SMBUS_READ_I2C_BLOCK)) return -EOPNOTSUPP;
+    if(length == 0 || length > I2C_SMBUS_BLOCK_MAX) return -EINVAL;
+
+    auto reg = regAddr;
+    i2c_msg messages[2] = {{deviceAddr, 0, 1, &reg}, {deviceAddr, I2C_M_RD, length, value}};
+    const auto result = Run(messages, 2);
+    return result < 0 ? result : 0;
+}
+
+int SimI2CTransport::SmbusWriteBlock(const unsigned char deviceAddr,
+                                     const unsigned char regAddr,
+                                     const unsigned char* value,
+                                     const unsigned char length)
+{
+    if(!(_functionality & I2C_FUNC_SMBUS_WRITE_I2C_BLOCK)) return -EOPNOTSUPP;
+    if(length == 0 || length > I2C_SMBUS_BLOCK_MAX) return -EINVAL;
+
+    unsigned char buffer[I2C_SMBUS_BLOCK_MAX + 1];
+    buffer[0] = regAddr;
+    std::copy(value, value + length, buffer + 1);
+    i2c_msg message = {deviceAddr, 0, static_cast<unsigned short>(length + 1), buffer};
+    const auto result = Run(&message, 1);
+    return result < 0 ? result : 0;
+}
+
+int SimI2CTransport::PlainRead(const unsigned char deviceAddr,
+                               const unsigned char regAddr,
+                               unsigned char* value,
+                               const unsigned short length)
+{
+    if(!(_functionality & I2C_FUNC_I2C)) return -EOPNOTSUPP;
+
+    auto reg = regAddr;
+    i2c_msg pointer = {deviceAddr, 0, 1, &reg};
+    auto result = Run(&pointer, 1);
+    if(result < 0) return result;
+    i2c_msg data = {deviceAddr, I2C_M_RD, length, value};
+    result = Run(&data, 1);
+    return result < 0 ? result : 0;
+}
+
+int SimI2CTransport::PlainWrite(const unsigned char deviceAddr, const unsigned char* data, const unsigned short length)
+{
+    if(!(_functionality & I2C_FUNC_I2C)) return -EOPNOTSUPP;
+
+    i2c_msg message = {deviceAddr, 0, length, const_cast<unsigned char*>(data)};
+    const auto result = Run(&message, 1);
+    return result < 0 ? result : 0;
+}
+
+unsigned long SimI2CTransport::Functionality()
+{
+    return _functionality;
+}
+
+unsigned int SimI2CTransport::ClockRate() const
+{
+    return _clockRate;
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   SimI2CTransport.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include <array>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include "I2CTransport.hpp"
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * SimI2CDevice register model of a chip with an auto increment register pointer
+ * the first written byte of a message sets the pointer, following bytes are written
+ */
+class SimI2CDevice
+{
+  protected:
+    std::array<unsigned char, 256> _registers{};
+    unsigned char _pointer{};
+    mutable std::mutex _mtx;
+
+    virtual unsigned char ReadRegister(unsigned char regAddr);
+    virtual void WriteRegister(unsigned char regAddr, unsigned char value);
+    virtual unsigned char NextRegister(unsigned char regAddr) const;
+
+  public:
+    SimI2CDevice() = default;
+    SimI2CDevice(const SimI2CDevice& orig) = delete;
+    SimI2CDevice& operator=(const SimI2CDevice& other) = delete;
+    virtual ~SimI2CDevice() = default;
+
+    virtual void Write(const unsigned char* data, unsigned short length);
+    virtual void Read(unsigned char* data, unsigned short length);
+    /**
+     * Power on state
+     */
+    virtual void Reset();
+    /**
+     * Register access for tests, without side effects
+     */
+    unsigned char Peek(unsigned char regAddr) const;
+    void Poke(unsigned char regAddr, unsigned char value);
+};
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * SimI2CTransport in memory bus for running drivers and benchmarks without hardware
+ * Optional every transfer takes the wire time of the configured clock plus a
+ * fixed per transfer overhead (driver, interrupt), like a real adapter.
+ */
+class SimTCA9548A;
+
+class SimI2CTransport : public I2CTransport
+{
+    std::map<unsigned char, std::shared_ptr<SimI2CDevice>> _devices;
+    std::map<unsigned char, std::shared_ptr<SimTCA9548A>> _muxes;
+    std::mutex _mtx;
+    unsigned int _clockRate;
+    std::chrono::microseconds _overhead;
+    bool _simulateLatency;
+    unsigned long _functionality;
+
+    std::shared_ptr<SimI2CDevice> FindDevice(unsigned char deviceAddr) const;
+    int Run(i2c_msg* messages, unsigned int count);
+    void WaitWireTime(std::chrono::steady_clock::time_point start, const i2c_msg* messages, unsigned int count) const;
+
+  public:
+    /**
+     * Create an empty simulated bus
+     * @param clockRate
+     *    bus clock in Hz
+     * @param overhead
+     *    time every transfer costs on top of the wire time
+     */
+    explicit SimI2CTransport(unsigned int clockRate = 100000, std::chrono::microseconds overhead = std::chrono::microseconds(50));
+    SimI2CTransport(const SimI2CTransport& orig) = delete;
+    SimI2CTransport& operator=(const SimI2CTransport& other) = delete;
+    ~SimI2CTransport() override = default;
+
+    /**
+     * Add a chip, a SimTCA9548A also makes the devices of its selected channels visible
+     */
+    void AddDevice(unsigned char deviceAddr, const std::shared_ptr<SimI2CDevice>& device);
+    void RemoveDevice(unsigned char deviceAddr);
+    /**
+     * Switch the latency of the transfers on (default) or off
+     */
+    void SetLatencySimulation(bool enabled);
+    void SetFunctionality(unsigned long functionality);
+
+    int Transfer(i2c_msg* messages, unsigned int count) override;
+    /**
+     * SMBus block costs one transfer, the plain read two (register write, stop, read)
+     */
+    int SmbusReadBlock(unsigned char deviceAddr, unsigned char regAddr, unsigned char* value, unsigned char length) override;
+    int SmbusWriteBlock(unsigned char deviceAddr, unsigned char regAddr, const unsigned char* value, unsigned char length) override;
+    int PlainRead(unsigned char deviceAddr, unsigned char regAddr, unsigned char* value, unsigned short length) override;
+    int PlainWrite(unsigned char deviceAddr, const unsigned char* data, unsigned short length) override;
+    unsigned long Functionality() override;
+    unsigned int ClockRate() const override;
+};
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   SimMCP23017.cpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#include "SimMCP23017.hpp"
+
+#define MCP23017_IODIRA 0x00
+#define MCP23017_IPOLA 0x02
+#define MCP23017_IOCON 0x0A
+#define MCP23017_IOCON_MIRROR 0x0B
+#define MCP23017_INTFA 0x0E
+#define MCP23017_INTCAPB 0x11
+#define MCP23017_GPIOA 0x12
+#define MCP23017_GPIOB 0x13
+#define MCP23017_OLATA 0x14
+#define MCP23017_LAST 0x15
+#define MCP23017_IOCON_SEQOP 0x20
+
+SimMCP23017::SimMCP23017()
+{
+    SimMCP23017::Reset();
+}
+
+void SimMCP23017::Reset()
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    _registers.fill(0x00);
+    _registers[MCP23017_IODIRA] = 0xFF;
+    _registers[MCP23017_IODIRA + 1] = 0xFF;
+    _pointer = 0;
+}
+
+unsigned char SimMCP23017::ReadRegister(const unsigned char regAddr)
+{
+    if(regAddr == MCP23017_GPIOA || regAddr == MCP23017_GPIOB) {
+        const auto port = regAddr - MCP23017_GPIOA;
+        const auto direction = _registers[MCP23017_IODIRA + port];
+        const auto inputs = static_cast<unsigned char>(_inputs >> (8 * port));
+        const auto inputLevel = static_cast<unsigned char>((inputs ^ _registers[MCP23017_IPOLA + port]) & direction);
+        return static_cast<unsigned char>((_registers[MCP23017_OLATA + port] & ~direction) | inputLevel);
+    }
+    if(regAddr > MCP23017_LAST) return 0x00;
+    return _registers[regAddr];
+}
+
+void SimMCP23017::WriteRegister(unsigned char regAddr, const unsigned char value)
+{
+    if(regAddr > MCP23017_LAST) return;
+    if(regAddr >= MCP23017_INTFA && regAddr <= MCP23017_INTCAPB) return; // read only
+    if(regAddr == MCP23017_GPIOA || regAddr == MCP23017_GPIOB) {
+        // a write to GPIO writes the latch
+        regAddr = static_cast<unsigned char>(regAddr + 2);
+    }
+    if(regAddr == MCP23017_IOCON || regAddr == MCP23017_IOCON_MIRROR) {
+        _registers[MCP23017_IOCON] = value;
+        _registers[MCP23017_IOCON_MIRROR] = value;
+        return;
+    }
+    _registers[regAddr] = value;
+}
+
+unsigned char SimMCP23017::NextRegister(const unsigned char regAddr) const
+{
+    if(_registers[MCP23017_IOCON] & MCP23017_IOCON_SEQOP) return regAddr;
+    if(regAddr >= MCP23017_LAST) return 0x00;
+    return static_cast<unsigned char>(regAddr + 1);
+}
+
+void SimMCP23017::SetInputs(const unsigned short inputs)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    _inputs = inputs;
+}
+
+unsigned short SimMCP23017::GetOutputs() const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    const auto latch = static_cast<unsigned short>(_registers[MCP23017_OLATA] | (_registers[MCP23017_OLATA + 1] << 8));
+    const auto direction = static_cast<unsigned short>(_registers[MCP23017_IODIRA] | (_registers[MCP23017_IODIRA + 1] << 8));
+    return static_cast<unsigned short>(latch & ~direction);
+}
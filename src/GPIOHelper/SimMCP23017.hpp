@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   SimMCP23017.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include "SimI2CTransport.hpp"
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * SimMCP23017 register model of the MCP23017 (IOCON.BANK = 0 only)
+ * GPIO reads combine the output latch and the simulated input levels,
+ * the address pointer wraps after OLATB or stays when IOCON.SEQOP is set.
+ */
+class SimMCP23017 : public SimI2CDevice
+{
+    unsigned short _inputs{};
+
+  protected:
+    unsigned char ReadRegister(unsigned char regAddr) override;
+    void WriteRegister(unsigned char regAddr, unsigned char value) override;
+    unsigned char NextRegister(unsigned char regAddr) const override;
+
+  public:
+    SimMCP23017();
+    void Reset() override;
+    /**
+     * Level at the pins configured as input, bit 0 - 7 port A, bit 8 - 15 port B
+     */
+    void SetInputs(unsigned short inputs);
+    /**
+     * Level of the pins configured as output, bit 0 - 7 port A, bit 8 - 15 port B
+     */
+    unsigned short GetOutputs() const;
+};
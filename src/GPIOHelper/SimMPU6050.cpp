@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   SimMPU6050.cpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#include "SimMPU6050.hpp"
+
+#define MPU6050_RA_ACCEL_XOUT_H 0x3B
+#define MPU6050_RA_SENSOR_LAST 0x60
+#define MPU6050_RA_PWR_MGMT_1 0x6B
+#define MPU6050_RA_WHO_AM_I 0x75
+#define MPU6050_PWR1_DEVICE_RESET 0x80
+#define MPU6050_PWR1_SLEEP 0x40
+
+SimMPU6050::SimMPU6050()
+{
+    SimMPU6050::Reset();
+}
+
+void SimMPU6050::Reset()
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    _registers.fill(0x00);
+    _registers[MPU6050_RA_PWR_MGMT_1] = MPU6050_PWR1_SLEEP;
+    _registers[MPU6050_RA_WHO_AM_I] = 0x68;
+    _pointer = 0;
+}
+
+void SimMPU6050::WriteRegister(const unsigned char regAddr, const unsigned char value)
+{
+    if(regAddr >= MPU6050_RA_ACCEL_XOUT_H && regAddr <= MPU6050_RA_SENSOR_LAST) return; // read only
+    if(regAddr == MPU6050_RA_WHO_AM_I) return;
+    if(regAddr == MPU6050_RA_PWR_MGMT_1 && (value & MPU6050_PWR1_DEVICE_RESET)) {
+        _registers.fill(0x00);
+        _registers[MPU6050_RA_PWR_MGMT_1] = MPU6050_PWR1_SLEEP;
+        _registers[MPU6050_RA_WHO_AM_I] = 0x68;
+        return;
+    }
+    _registers[regAddr] = value;
+}
+
+void SimMPU6050::SetMotion(const int16_t ax, const int16_t ay, const int16_t az, const int16_t gx, const int16_t gy, const int16_t gz, const int16_t temp)
+{
+    const int16_t values[7] = { ax, ay, az, temp, gx, gy, gz };
+    std::lock_guard<std::mutex> lock(_mtx);
+    for(auto index = 0; index < 7; index++) {
+        _registers[MPU6050_RA_ACCEL_XOUT_H + 2 * index] = static_cast<unsigned char>(static_cast<uint16_t>(values[index]) >> 8);
+        _registers[MPU6050_RA_ACCEL_XOUT_H + 2 * index + 1] = static_cast<unsigned char>(values[index] & 0xFF);
+    }
+}
+
+bool SimMPU6050::IsSleeping() const
+{
+    return (Peek(MPU6050_RA_PWR_MGMT_1) & MPU6050_PWR1_SLEEP) != 0;
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   SimMPU6050.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include <cstdint>
+#include "SimI2CTransport.hpp"
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * SimMPU6050 register model of the MPU6050 (see MPU5060)
+ * Starts sleeping like the chip, the sensor registers hold the values of SetMotion.
+ */
+class SimMPU6050 : public SimI2CDevice
+{
+  protected:
+    void WriteRegister(unsigned char regAddr, unsigned char value) override;
+
+  public:
+    SimMPU6050();
+    void Reset() override;
+    /**
+     * Raw sensor values as the chip would sample them
+     */
+    void SetMotion(int16_t ax, int16_t ay, int16_t az, int16_t gx, int16_t gy, int16_t gz, int16_t temp);
+    bool IsSleeping() const;
+};
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * File:   SimSpiTransport.cpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#include "SimSpiTransport.hpp"
+#include <linux/spi/spidev.h>
+#include <cstdint>
+#include <thread>
+
+unsigned char SimSpiDevice::ReadRegister(const unsigned char regAddr)
+{
+    return _registers[regAddr & 0x7F];
+}
+
+void SimSpiDevice::WriteRegister(const unsigned char regAddr, const unsigned char value)
+{
+    _registers[regAddr & 0x7F] = value;
+}
+
+void SimSpiDevice::Select()
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    _command = true;
+}
+
+void SimSpiDevice::Deselect()
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    _command = false;
+}
+
+unsigned char SimSpiDevice::Exchange(const unsigned char value)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    if(_command) {
+        _command = false;
+        _read = (value & 0x80) != 0;
+        _pointer = static_cast<unsigned char>(value & 0x7F);
+        return 0x00;
+    }
+
+    unsigned char result = 0x00;
+    if(_read) {
+        result = ReadRegister(_pointer);
+    } else {
+        WriteRegister(_pointer, value);
+    }
+    _pointer = static_cast<unsigned char>((_pointer + 1) & 0x7F);
+    return result;
+}
+
+unsigned char SimSpiDevice::Peek(const unsigned char regAddr) const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _registers[regAddr & 0x7F];
+}
+
+void SimSpiDevice::Poke(const unsigned char regAddr, const unsigned char value)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    _registers[regAddr & 0x7F] = value;
+}
+
+SimSpiTransport::SimSpiTransport(const unsigned int speedHz, const std::chrono::microseconds overhead)
+    : _speedHz(speedHz), _overhead(overhead), _simulateLatency(true)
+{
+}
+
+void SimSpiTransport::SetDevice(const std::shared_ptr<SimSpiDevice>& device)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    _device = device;
+}
+
+void SimSpiTransport::SetLatencySimulation(const bool enabled)
+{
+    _simulateLatency = enabled;
+}
+
+int SimSpiTransport::Transfer(spi_ioc_transfer* segments, const unsigned int count)
+{
+    const auto start = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(_mtx);
+
+    unsigned long bytes = 0;
+    auto selected = false;
+    for(unsigned int index = 0; index < count; index++) {
+        auto& segment = segments[index];
+        const auto* tx = reinterpret_cast<const unsigned char*>(static_cast<uintptr_t>(segment.tx_buf));
+        auto* rx = reinterpret_cast<unsigned char*>(static_cast<uintptr_t>(segment.rx_buf));
+
+        if(!selected && _device != nullptr) _device->Select();
+        selected = true;
+        for(unsigned int offset = 0; offset < segment.len; offset++) {
+            const unsigned char out = tx != nullptr ? tx[offset] : 0x00;
+            const unsigned char in = _device != nullptr ? _device->Exchange(out) : 0xFF;
+            if(rx != nullptr) rx[offset] = in;
+        }
+        bytes += segment.len;
+
+        // cs_change ends the command, on the last segment it would keep the chip selected
+        if(segment.cs_change && index + 1 < count) {
+            if(_device != nullptr) _device->Deselect();
+            selected = false;
+        }
+    }
+    if(selected && _device != nullptr) _device->Deselect();
+
+    if(_simulateLatency && _speedHz != 0) {
+        const auto end = start + _overhead + std::chrono::nanoseconds(bytes * 8ULL * 1000000000ULL / _speedHz);
+        while(std::chrono::steady_clock::now() < end) {
+            std::this_thread::yield();
+        }
+    }
+    return static_cast<int>(bytes);
+}
+
+unsigned int SimSpiTransport::SpeedHz() const
+{
+    return _speedHz;
+}
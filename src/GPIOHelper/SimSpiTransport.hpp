@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * File:   SimSpiTransport.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include <array>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include "SpiTransport.hpp"
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * SimSpiDevice register model of a typical spi sensor: the first byte after
+ * chip select is the command, bit 7 set is a read, bits 6..0 the register. The
+ * register pointer increments with every following byte.
+ */
+class SimSpiDevice
+{
+  protected:
+    std::array<unsigned char, 128> _registers{};
+    unsigned char _pointer{};
+    bool _read{};
+    bool _command{};
+    mutable std::mutex _mtx;
+
+    virtual unsigned char ReadRegister(unsigned char regAddr);
+    virtual void WriteRegister(unsigned char regAddr, unsigned char value);
+
+  public:
+    SimSpiDevice() = default;
+    SimSpiDevice(const SimSpiDevice& orig) = delete;
+    SimSpiDevice& operator=(const SimSpiDevice& other) = delete;
+    virtual ~SimSpiDevice() = default;
+
+    /**
+     * Chip select active, the next byte is a command
+     */
+    virtual void Select();
+    virtual void Deselect();
+    /**
+     * One byte full duplex
+     * @return byte on MISO
+     */
+    virtual unsigned char Exchange(unsigned char value);
+
+    unsigned char Peek(unsigned char regAddr) const;
+    void Poke(unsigned char regAddr, unsigned char value);
+};
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * SimSpiTransport one chip select with an in memory device, every message
+ * takes the clock time of its bytes plus a fixed overhead like spidev
+ */
+class SimSpiTransport : public SpiTransport
+{
+    std::shared_ptr<SimSpiDevice> _device;
+    std::mutex _mtx;
+    unsigned int _speedHz;
+    std::chrono::microseconds _overhead;
+    bool _simulateLatency;
+
+  public:
+    explicit SimSpiTransport(unsigned int speedHz = 8000000, std::chrono::microseconds overhead = std::chrono::microseconds(20));
+    SimSpiTransport(const SimSpiTransport& orig) = delete;
+    SimSpiTransport& operator=(const SimSpiTransport& other) = delete;
+    ~SimSpiTransport() override = default;
+
+    /**
+     * Device on the chip select, without one MISO reads 0xFF
+     */
+    void SetDevice(const std::shared_ptr<SimSpiDevice>& device);
+    void SetLatencySimulation(bool enabled);
+
+    int Transfer(spi_ioc_transfer* segments, unsigned int count) override;
+    unsigned int SpeedHz() const override;
+};
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   SimTCA9548A.cpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#include "SimTCA9548A.hpp"
+
+void SimTCA9548A::Write(const unsigned char* data, const unsigned short length)
+{
+    if(length == 0) return;
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    _registers[0] = data[length - 1];
+    _selectWrites++;
+}
+
+void SimTCA9548A::Read(unsigned char* data, const unsigned short length)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    for(unsigned short index = 0; index < length; index++) {
+        data[index] = _registers[0];
+    }
+}
+
+void SimTCA9548A::AddDevice(const unsigned char channel, const unsigned char deviceAddr, const std::shared_ptr<SimI2CDevice>& device)
+{
+    if(channel > 7) return;
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    _channels[channel][deviceAddr] = device;
+}
+
+std::shared_ptr<SimI2CDevice> SimTCA9548A::FindDevice(const unsigned char deviceAddr) const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    for(unsigned char channel = 0; channel < 8; channel++) {
+        if((_registers[0] & (1 << channel)) == 0) continue;
+        const auto device = _channels[channel].find(deviceAddr);
+        if(device != _channels[channel].end()) return device->second;
+    }
+    return nullptr;
+}
+
+unsigned char SimTCA9548A::GetChannels() const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _registers[0];
+}
+
+unsigned long SimTCA9548A::GetSelectWrites() const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _selectWrites;
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   SimTCA9548A.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include <map>
+#include <memory>
+#include "SimI2CTransport.hpp"
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * SimTCA9548A model of the multiplexer (see TCA9548A), one control register
+ * every written byte selects the channels, the devices of all selected channels answer
+ */
+class SimTCA9548A : public SimI2CDevice
+{
+    std::array<std::map<unsigned char, std::shared_ptr<SimI2CDevice>>, 8> _channels;
+    unsigned long _selectWrites{};
+
+  public:
+    SimTCA9548A() = default;
+    void Write(const unsigned char* data, unsigned short length) override;
+    void Read(unsigned char* data, unsigned short length) override;
+
+    void AddDevice(unsigned char channel, unsigned char deviceAddr, const std::shared_ptr<SimI2CDevice>& device);
+    /**
+     * @return the device on a selected channel or nullptr
+     */
+    std::shared_ptr<SimI2CDevice> FindDevice(unsigned char deviceAddr) const;
+    unsigned char GetChannels() const;
+    unsigned long GetSelectWrites() const;
+};
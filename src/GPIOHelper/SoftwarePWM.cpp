@@ -30,33 +30,99 @@
 #endif
 
 #include "../common/easylogging/easylogging++.h"
+#include "../common/exception/ConfigErrorException.hpp"
 #include "SoftwarePWM.hpp"
+#include <chrono>
 #include <thread>
-#include "../common/utils/ElapsedTimer.hpp"
 #include "GpioPin.hpp"
 #include <iostream>
 
-void SoftwarePWM::PwmTrigger() const {
+#define PWM_PERIOD_SHIFT 32
+#define PWM_DUTY_MASK 0xFFFFULL
+#define PWM_PERIOD_MASK (0xFFFFFFFFULL << PWM_PERIOD_SHIFT)
+
+static std::uint64_t PeriodFromFrequency(const unsigned int frq) {
+    return static_cast<std::uint64_t>(1000000 / frq); // microsecond
+}
+
+static unsigned int DutyFromSignal(const unsigned int signal) {
+    if(signal >= 1000) {
+        return SoftwarePWM::DutyMax;
+    }
+    return static_cast<unsigned int>((signal * SoftwarePWM::DutyMax + 500) / 1000);
+}
+
+void SoftwarePWM::PwmTrigger() {
     el::Helpers::setThreadName("SoftwarePWM");
-    ElapsedTimer timer(true);
+    auto periodStart = std::chrono::steady_clock::now();
+    auto pinState = -1;
+
     while(_threadRun) {
-        *_pin << 1;
-        std::this_thread::sleep_for(std::chrono::microseconds(_signalTime));
-        *_pin << 0;
-        std::this_thread::sleep_for(std::chrono::microseconds(_periodTime) - timer.Elapsed());
-        timer.Reset();
+        if(_rampActive.load(std::memory_order_acquire)) {
+            EvaluateRamp(periodStart);
+        }
+
+        // latch period and duty together, changes only take effect here
+        const auto setting = _setting.load(std::memory_order_acquire);
+        const auto periodTime = std::chrono::microseconds(setting >> PWM_PERIOD_SHIFT);
+        const auto duty = setting & PWM_DUTY_MASK;
+        const auto signalTime = std::chrono::nanoseconds((periodTime.count() * 1000 * duty + DutyMax / 2) / DutyMax);
+
+        if(signalTime.count() > 0 && pinState != 1) {
+            *_pin << 1;
+            pinState = 1;
+        }
+        if(signalTime < periodTime) {
+            if(signalTime.count() > 0) {
+                std::this_thread::sleep_until(periodStart + signalTime);
+            }
+            if(pinState != 0) {
+                *_pin << 0;
+                pinState = 0;
+            }
+        }
+
+        periodStart += periodTime;
+        const auto now = std::chrono::steady_clock::now();
+        if(now > periodStart + periodTime) {
+            // we are more than one period behind, do not try to catch up with runt pulses
+            periodStart = now;
+        }
+        std::this_thread::sleep_until(periodStart);
+    }
+}
+
+void SoftwarePWM::EvaluateRamp(const std::chrono::steady_clock::time_point now) {
+    pwm_ramp_delegate finished;
+    {
+        std::lock_guard<std::mutex> lock(_rampMtx);
+        StoreSetting(PWM_DUTY_MASK, _ramp.Evaluate(now, finished));
+        _rampActive = _ramp.IsActive();
+    }
+    if(finished != nullptr) {
+        finished(true);
+    }
+}
+
+void SoftwarePWM::StoreSetting(const std::uint64_t mask, const std::uint64_t value) {
+    auto current = _setting.load(std::memory_order_relaxed);
+    while(!_setting.compare_exchange_weak(current, (current & ~mask) | (value & mask), std::memory_order_release,
+                                          std::memory_order_relaxed)) {
     }
 }
 
 SoftwarePWM::SoftwarePWM(GpioPin* pin, const unsigned int frq, const unsigned int signal) {
     el::Loggers::getLogger(ELPP_DEFAULT_LOGGER);
     LOG(DEBUG) << "Start SoftwarePWM Constructor ... ";
+    if(frq == 0 || frq > 1000000) {
+        throw ConfigErrorException("SoftwarePWM frequenz must be 1 - 1000000 Hz");
+    }
     _pin = pin;
-    _periodTime = static_cast<unsigned long>(1.0 / frq * 1000000); // microsecond
     _threadRun = true;
-    _signalTime = static_cast<unsigned long>(_periodTime * (signal / 10) / 100);
-    LOG(DEBUG) << "signalTime is " << _signalTime;
-    LOG(DEBUG) << "periodTime is " << _periodTime;
+    _rampActive = false;
+    _setting = (PeriodFromFrequency(frq) << PWM_PERIOD_SHIFT) | DutyFromSignal(signal);
+    LOG(DEBUG) << "duty is " << DutyFromSignal(signal);
+    LOG(DEBUG) << "periodTime is " << PeriodFromFrequency(frq);
     _pwmThread = std::thread(&SoftwarePWM::PwmTrigger, this);
 }
 
@@ -69,6 +135,55 @@ SoftwarePWM::~SoftwarePWM() {
 }
 
 void SoftwarePWM::ChangeSignal(unsigned int signal) {
-    _signalTime = static_cast<unsigned long>(_periodTime * (signal / 10) / 100);
-    LOG(DEBUG) << "signalTime is " << _signalTime;
+    ChangeDuty(DutyFromSignal(signal));
+}
+
+void SoftwarePWM::ChangeDuty(unsigned int duty) {
+    if(duty > DutyMax) {
+        duty = DutyMax;
+    }
+    pwm_ramp_delegate stopped;
+    {
+        std::lock_guard<std::mutex> lock(_rampMtx);
+        stopped = _ramp.Cancel();
+        _rampActive = false;
+        StoreSetting(PWM_DUTY_MASK, duty);
+    }
+    if(stopped != nullptr) {
+        stopped(false);
+    }
+    LOG(DEBUG) << "duty is " << duty;
+}
+
+void SoftwarePWM::Ramp(unsigned int duty,
+                       const std::chrono::milliseconds duration,
+                       const pwm_ramp_curve curve,
+                       const pwm_ramp_delegate& callback) {
+    if(duty > DutyMax) {
+        duty = DutyMax;
+    }
+    pwm_ramp_delegate replaced;
+    {
+        std::lock_guard<std::mutex> lock(_rampMtx);
+        replaced = _ramp.Start(GetDuty(), duty, DutyMax, duration, curve, callback);
+        _rampActive = true;
+    }
+    if(replaced != nullptr) {
+        replaced(false);
+    }
+    LOG(DEBUG) << "ramp to " << duty << " in " << duration.count() << "ms";
+}
+
+int SoftwarePWM::SetFrequency(const unsigned int frq) {
+    if(frq == 0 || frq > 1000000) {
+        LOG(ERROR) << "frequenz must be 1 - 1000000 Hz";
+        return -9;
+    }
+    StoreSetting(PWM_PERIOD_MASK, PeriodFromFrequency(frq) << PWM_PERIOD_SHIFT);
+    LOG(DEBUG) << "periodTime is " << PeriodFromFrequency(frq);
+    return 0;
+}
+
+unsigned int SoftwarePWM::GetDuty() const {
+    return static_cast<unsigned int>(_setting.load(std::memory_order_relaxed) & PWM_DUTY_MASK);
 }
@@ -23,7 +23,12 @@
   */
 
 #pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
 #include <thread>
+#include "PwmRamp.hpp"
 
 class GpioPin;
 
@@ -31,17 +36,30 @@ class GpioPin;
   * \ingroup SystemFunctions
   *
   * SoftwarePWM
+  *
+  * Duty and frequency changes are stored in one atomic word and latched by
+  * the pwm thread at the next period boundary, so a period is never cut
+  * short or stretched by an update from another thread.
   */
 class SoftwarePWM {
     GpioPin* _pin;
-    unsigned long _periodTime;
-    unsigned long _signalTime;
+    // period in microsecond (upper 32 bit) and duty 0 - DutyMax (lower 16 bit)
+    std::atomic<std::uint64_t> _setting;
     std::thread _pwmThread;
-    bool _threadRun;
-    unsigned char _pause{};
+    std::atomic<bool> _threadRun;
+    PwmRamp _ramp;
+    std::mutex _rampMtx;
+    std::atomic<bool> _rampActive;
 
-    void PwmTrigger(void) const;
+    void PwmTrigger();
+    void EvaluateRamp(std::chrono::steady_clock::time_point now);
+    void StoreSetting(std::uint64_t mask, std::uint64_t value);
 public:
+    /**
+     * Full scale duty value (100 %)
+     */
+    static constexpr unsigned int DutyMax = 0xFFFF;
+
     /**
      * Create new SoftwarePWM Thread
      * @param pin
@@ -64,4 +82,35 @@ public:
      *    signal length 0 - 1000 (0.0 - 100.0 %)
      */
     void ChangeSignal(unsigned int signal);
+    /**
+     * Change Duty with full resolution, takes effect at the next period
+     * a running ramp is stopped
+     * @param duty
+     *    duty 0 - DutyMax (0.0 - 100.0 %)
+     */
+    void ChangeDuty(unsigned int duty);
+    /**
+     * Change the Frequenz without restarting the thread, takes effect at the next period
+     * @param frq
+     *    The Freqenz in Hz
+     * @return 0 ok, < 0 invalid frequenz
+     */
+    int SetFrequency(unsigned int frq);
+    /**
+     * Move the duty to target within duration, the pwm thread updates the duty every period
+     * @param duty
+     *    target duty 0 - DutyMax (0.0 - 100.0 %)
+     * @param duration
+     *    the time for the whole ramp
+     * @param curve
+     *    see pwm_ramp_curve
+     * @param callback
+     *    called from the pwm thread when the ramp ends (true), keep it short,
+     *    a ramp replaced by ChangeDuty / Ramp gets false on the caller thread
+     */
+    void Ramp(unsigned int duty,
+              std::chrono::milliseconds duration,
+              pwm_ramp_curve curve = pwm_ramp_curve::linear,
+              const pwm_ramp_delegate& callback = nullptr);
+    unsigned int GetDuty() const;
 };
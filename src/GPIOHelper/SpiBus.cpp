@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * File:   SpiBus.cpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#ifndef ELPP_DEFAULT_LOGGER
+#define ELPP_DEFAULT_LOGGER "SpiBus"
+#endif
+#ifndef ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID
+#define ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID ELPP_DEFAULT_LOGGER
+#endif
+
+#include "SpiBus.hpp"
+#include <vector>
+#include "../common/easylogging/easylogging++.h"
+#include "../common/exception/NullPointerException.hpp"
+#include "LinuxSpiTransport.hpp"
+
+SpiBus::SpiBus(const std::string& device, const unsigned char mode, const unsigned int speedHz, const unsigned char bitsPerWord)
+    : SpiBus(std::make_unique<LinuxSpiTransport>(device, mode, speedHz, bitsPerWord))
+{
+}
+
+SpiBus::SpiBus(std::unique_ptr<SpiTransport> transport)
+{
+    el::Loggers::getLogger(ELPP_DEFAULT_LOGGER);
+    if(transport == nullptr) {
+        throw NullPointerException("transport");
+    }
+    _transport = std::move(transport);
+}
+
+int SpiBus::Transfer(spi_ioc_transfer* segments, const unsigned int count)
+{
+    if(count == 0 || count > SPI_MESSAGE_MAX_SEGMENTS) return -9;
+    // spidev refuses a message over its buffer with EMSGSIZE
+    unsigned long length = 0;
+    for(unsigned int index = 0; index < count; index++) {
+        length += segments[index].len;
+    }
+    if(length > SPI_MESSAGE_MAX_BYTES) return -9;
+
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _transport->Transfer(segments, count);
+}
+
+int SpiBus::Execute(SpiTransaction& transaction)
+{
+    if(!transaction.Valid()) {
+        LOG(ERROR) << "SPI transaction with an empty or too long command";
+        return -9;
+    }
+    if(transaction.Empty()) return 0;
+
+    std::vector<spi_ioc_transfer> segments;
+    std::vector<unsigned char> groups;
+    transaction.BuildSegments(segments, groups);
+
+    std::size_t first = 0;
+    std::size_t group = 0;
+    auto bytes = 0;
+    while(first < segments.size()) {
+        // fill the ioctl up to the spidev limits without splitting a command
+        std::size_t count = 0;
+        unsigned long length = 0;
+        while(group < groups.size()) {
+            unsigned long groupLength = 0;
+            for(std::size_t index = 0; index < groups[group]; index++) {
+                groupLength += segments[first + count + index].len;
+            }
+            if(count > 0 && (count + groups[group] > SPI_MESSAGE_MAX_SEGMENTS || length + groupLength > SPI_MESSAGE_MAX_BYTES)) break;
+            count += groups[group];
+            length += groupLength;
+            group++;
+        }
+
+        // cs_change on the last segment would keep the chip selected after the ioctl
+        segments[first + count - 1].cs_change = 0;
+        const auto retVal = Transfer(&segments[first], static_cast<unsigned int>(count));
+        if(retVal < 0) {
+            LOG(DEBUG) << "transfer failed " << retVal;
+            return retVal;
+        }
+        bytes += retVal;
+        first += count;
+    }
+
+    return bytes;
+}
+
+unsigned int SpiBus::GetSpeedHz() const
+{
+    return _transport->SpeedHz();
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * File:   SpiBus.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include <memory>
+#include <mutex>
+#include <string>
+#include "SpiTransaction.hpp"
+#include "SpiTransport.hpp"
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * SpiBus one spidev chip select. All access is serialised by a mutex, an
+ * SpiTransaction is sent with as few ioctls as possible.
+ */
+class SpiBus
+{
+    std::unique_ptr<SpiTransport> _transport;
+    std::mutex _mtx;
+
+  public:
+    /**
+     * Open a spidev device
+     * @param device
+     *    sample /dev/spidev0.0
+     * @param mode
+     *    SPI_MODE_0 - SPI_MODE_3
+     */
+    explicit SpiBus(const std::string& device, unsigned char mode = 0, unsigned int speedHz = 1000000, unsigned char bitsPerWord = 8);
+    /**
+     * Create new SpiBus on any transport
+     * @param transport
+     *    see SpiTransport, sample SimSpiTransport for tests
+     */
+    explicit SpiBus(std::unique_ptr<SpiTransport> transport);
+    SpiBus(const SpiBus& orig) = delete;
+    SpiBus(SpiBus&& other) = delete;
+    SpiBus& operator=(const SpiBus& other) = delete;
+    SpiBus& operator=(SpiBus&& other) = delete;
+    virtual ~SpiBus() = default;
+
+    /**
+     * Send prepared segments in one ioctl
+     * @return number of bytes clocked, < 0 the negative errno (-9 more than
+     *    SPI_MESSAGE_MAX_SEGMENTS segments or SPI_MESSAGE_MAX_BYTES bytes)
+     */
+    int Transfer(spi_ioc_transfer* segments, unsigned int count);
+    /**
+     * Send all commands of the transaction, one ioctl per SPI_MESSAGE_MAX_SEGMENTS
+     * segments or SPI_MESSAGE_MAX_BYTES bytes
+     * @return number of bytes clocked, < 0 failed (-9 the transaction holds an invalid command)
+     */
+    int Execute(SpiTransaction& transaction);
+    unsigned int GetSpeedHz() const;
+};
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * File:   SpiDevice.cpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#include "SpiDevice.hpp"
+#include <cstdint>
+#include "../common/exception/NullPointerException.hpp"
+
+SpiDevice::SpiDevice(SpiBus* bus, const unsigned char readFlag, const unsigned char incrementFlag)
+    : _readFlag(readFlag), _incrementFlag(incrementFlag)
+{
+    if(bus == nullptr) {
+        throw NullPointerException("bus");
+    }
+    _bus = bus;
+}
+
+unsigned char SpiDevice::Command(const unsigned char regAddr, const unsigned int length, const bool read) const
+{
+    auto command = static_cast<unsigned char>(regAddr & ~(_readFlag | _incrementFlag));
+    if(read) command |= _readFlag;
+    if(length > 1) command |= _incrementFlag;
+    return command;
+}
+
+int SpiDevice::ReadByte(const unsigned char regAddr, unsigned char& value) const
+{
+    return ReadBytes(regAddr, 1, &value);
+}
+
+int SpiDevice::ReadBytes(const unsigned char regAddr, const unsigned int length, unsigned char* value) const
+{
+    if(length == 0 || value == nullptr) return -9;
+
+    auto command = Command(regAddr, length, true);
+    spi_ioc_transfer segments[2] = {};
+    segments[0].tx_buf = reinterpret_cast<uintptr_t>(&command);
+    segments[0].len = 1;
+    segments[1].rx_buf = reinterpret_cast<uintptr_t>(value);
+    segments[1].len = length;
+    return _bus->Transfer(segments, 2);
+}
+
+int SpiDevice::WriteByte(const unsigned char regAddr, const unsigned char value) const
+{
+    return WriteBytes(regAddr, 1, &value);
+}
+
+int SpiDevice::WriteBytes(const unsigned char regAddr, const unsigned int length, const unsigned char* value) const
+{
+    if(length == 0 || value == nullptr) return -9;
+
+    // command and data as two segments of one frame, the data is not copied
+    auto command = Command(regAddr, length, false);
+    spi_ioc_transfer segments[2] = {};
+    segments[0].tx_buf = reinterpret_cast<uintptr_t>(&command);
+    segments[0].len = 1;
+    segments[1].tx_buf = reinterpret_cast<uintptr_t>(value);
+    segments[1].len = length;
+    return _bus->Transfer(segments, 2);
+}
+
+int SpiDevice::Transfer(const unsigned char* tx, unsigned char* rx, const unsigned int length) const
+{
+    if(length == 0 || tx == nullptr) return -9;
+
+    spi_ioc_transfer segment{};
+    segment.tx_buf = reinterpret_cast<uintptr_t>(tx);
+    segment.rx_buf = reinterpret_cast<uintptr_t>(rx);
+    segment.len = length;
+    return _bus->Transfer(&segment, 1);
+}
+
+void SpiDevice::AddReadBytes(SpiTransaction& transaction, const unsigned char regAddr, const unsigned int length, unsigned char* value) const
+{
+    transaction.AddReadBytes(Command(regAddr, length, true), length, value);
+}
+
+void SpiDevice::AddWriteBytes(SpiTransaction& transaction,
+                              const unsigned char regAddr,
+                              const unsigned int length,
+                              const unsigned char* value) const
+{
+    transaction.AddWriteBytes(Command(regAddr, length, false), length, value);
+}
+
+int SpiDevice::Execute(SpiTransaction& transaction) const
+{
+    return _bus->Execute(transaction);
+}
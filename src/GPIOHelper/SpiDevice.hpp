@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * File:   SpiDevice.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include "SpiBus.hpp"
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * SpiDevice register access of a chip on a SpiBus. The command byte is the
+ * register with the read flag for reads and the increment flag for multi byte
+ * access (sample LIS3DH read 0x80, increment 0x40, MPU-9250 read 0x80).
+ */
+class SpiDevice
+{
+    SpiBus* _bus;
+    unsigned char _readFlag;
+    unsigned char _incrementFlag;
+
+    unsigned char Command(unsigned char regAddr, unsigned int length, bool read) const;
+
+  public:
+    /**
+     * Create new SpiDevice
+     * @param bus
+     *    see SpiBus
+     * @param readFlag
+     *    bits set in the command byte of a read
+     * @param incrementFlag
+     *    bits set in the command byte of a multi byte access, 0 the chip always increments
+     */
+    explicit SpiDevice(SpiBus* bus, unsigned char readFlag = 0x80, unsigned char incrementFlag = 0x00);
+    SpiDevice(const SpiDevice& orig) = delete;
+    SpiDevice(SpiDevice&& other) = delete;
+    SpiDevice& operator=(const SpiDevice& other) = delete;
+    SpiDevice& operator=(SpiDevice&& other) = delete;
+    ~SpiDevice() = default;
+
+    int ReadByte(unsigned char regAddr, unsigned char& value) const;
+    int ReadBytes(unsigned char regAddr, unsigned int length, unsigned char* value) const;
+    int WriteByte(unsigned char regAddr, unsigned char value) const;
+    int WriteBytes(unsigned char regAddr, unsigned int length, const unsigned char* value) const;
+    /**
+     * Full duplex frame without command byte
+     * @param rx
+     *    may be nullptr
+     */
+    int Transfer(const unsigned char* tx, unsigned char* rx, unsigned int length) const;
+
+    /**
+     * Queue register access in a transaction, see SpiBus::Execute
+     */
+    void AddReadBytes(SpiTransaction& transaction, unsigned char regAddr, unsigned int length, unsigned char* value) const;
+    void AddWriteBytes(SpiTransaction& transaction, unsigned char regAddr, unsigned int length, const unsigned char* value) const;
+    int Execute(SpiTransaction& transaction) const;
+};
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * File:   SpiTransaction.cpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#include "SpiTransaction.hpp"
+#include <cstdint>
+
+void SpiTransaction::AddReadBytes(const unsigned char command, const unsigned int length, unsigned char* value)
+{
+    if(length == 0 || length + 1 > SPI_MESSAGE_MAX_BYTES || value == nullptr) {
+        _invalid = true;
+        return;
+    }
+    Entry entry{ _txData.size(), 1, value, length, false };
+    _txData.push_back(command);
+    _entries.push_back(entry);
+}
+
+void SpiTransaction::AddWriteBytes(const unsigned char command, const unsigned int length, const unsigned char* value)
+{
+    if(length + 1 > SPI_MESSAGE_MAX_BYTES || (length > 0 && value == nullptr)) {
+        _invalid = true;
+        return;
+    }
+    Entry entry{ _txData.size(), length + 1, nullptr, 0, false };
+    _txData.push_back(command);
+    _txData.insert(_txData.end(), value, value + length);
+    _entries.push_back(entry);
+}
+
+void SpiTransaction::AddTransfer(const unsigned char* tx, unsigned char* rx, const unsigned int length)
+{
+    if(length == 0 || length > SPI_MESSAGE_MAX_BYTES || tx == nullptr) {
+        _invalid = true;
+        return;
+    }
+    Entry entry{ _txData.size(), length, rx, length, true };
+    _txData.insert(_txData.end(), tx, tx + length);
+    _entries.push_back(entry);
+}
+
+void SpiTransaction::Clear()
+{
+    _entries.clear();
+    _txData.clear();
+    _invalid = false;
+}
+
+bool SpiTransaction::Empty() const
+{
+    return _entries.empty();
+}
+
+bool SpiTransaction::Valid() const
+{
+    return !_invalid;
+}
+
+void SpiTransaction::BuildSegments(std::vector<spi_ioc_transfer>& segments, std::vector<unsigned char>& groups)
+{
+    segments.clear();
+    groups.clear();
+    segments.reserve(_entries.size() * 2);
+    groups.reserve(_entries.size());
+
+    // the tx data is complete now, so the pointers into it stay valid
+    for(const auto& entry : _entries) {
+        spi_ioc_transfer segment{};
+        segment.tx_buf = reinterpret_cast<uintptr_t>(&_txData[entry.txOffset]);
+        segment.len = entry.txLength;
+        if(entry.duplex) segment.rx_buf = reinterpret_cast<uintptr_t>(entry.rxBuffer);
+
+        if(entry.duplex || entry.rxBuffer == nullptr) {
+            segment.cs_change = 1;
+            segments.push_back(segment);
+            groups.push_back(1);
+            continue;
+        }
+
+        segments.push_back(segment);
+        segment = spi_ioc_transfer{};
+        segment.rx_buf = reinterpret_cast<uintptr_t>(entry.rxBuffer);
+        segment.len = entry.rxLength;
+        segment.cs_change = 1;
+        segments.push_back(segment);
+        groups.push_back(2);
+    }
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * File:   SpiTransaction.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include <linux/spi/spidev.h>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Most segments in one SPI_IOC_MESSAGE ioctl
+ */
+#define SPI_MESSAGE_MAX_SEGMENTS 64
+
+/**
+ * Most bytes in one ioctl, the default spidev bufsiz
+ */
+#define SPI_MESSAGE_MAX_BYTES 4096
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * SpiTransaction collects commands for one chip select that SpiBus::Execute
+ * sends with as few SPI_IOC_MESSAGE ioctls as the spidev limits allow. Every
+ * command runs in its own chip select frame (cs_change between them). Read
+ * results go straight to the caller buffers, they must stay valid until
+ * Execute returns. A command has to fit one ioctl (SPI_MESSAGE_MAX_BYTES
+ * including the command byte) and move at least one byte, else the
+ * transaction is invalid until Clear.
+ */
+class SpiTransaction
+{
+    struct Entry {
+        std::size_t txOffset;
+        unsigned int txLength;
+        unsigned char* rxBuffer;
+        unsigned int rxLength;
+        // tx and rx in the same segment
+        bool duplex;
+    };
+
+    std::vector<Entry> _entries;
+    std::vector<unsigned char> _txData;
+    // a rejected command, Execute sends nothing
+    bool _invalid{};
+
+  public:
+    SpiTransaction() = default;
+
+    /**
+     * Command byte, then length bytes read
+     */
+    void AddReadBytes(unsigned char command, unsigned int length, unsigned char* value);
+    /**
+     * Command byte followed by the bytes, the bytes are copied
+     */
+    void AddWriteBytes(unsigned char command, unsigned int length, const unsigned char* value);
+    /**
+     * Full duplex frame, sample an ADC conversion
+     * @param rx
+     *    may be nullptr, gets length bytes
+     */
+    void AddTransfer(const unsigned char* tx, unsigned char* rx, unsigned int length);
+
+    void Clear();
+    bool Empty() const;
+    /**
+     * @return false a command was rejected
+     */
+    bool Valid() const;
+
+    /**
+     * Fill the spi segments, the last segment of every command has cs_change set
+     * @param segments
+     *    replaced by the segments, valid until the transaction is changed
+     * @param groups
+     *    number of segments of every command, a command must not be split over two ioctls
+     */
+    void BuildSegments(std::vector<spi_ioc_transfer>& segments, std::vector<unsigned char>& groups);
+};
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * File:   SpiTransport.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+
+struct spi_ioc_transfer;
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * SpiTransport moves spi segments over one chip select, SpiBus sits on top of it
+ * see LinuxSpiTransport (/dev/spidevB.C) and SimSpiTransport (in memory device)
+ */
+class SpiTransport
+{
+  public:
+    virtual ~SpiTransport() = default;
+
+    /**
+     * Send the segments as one message, like SPI_IOC_MESSAGE(count). The chip select
+     * stays active between the segments, a segment with cs_change ends the command.
+     * @return number of bytes clocked, < 0 the negative errno
+     */
+    virtual int Transfer(spi_ioc_transfer* segments, unsigned int count) = 0;
+    /**
+     * Configured clock in Hz, used to estimate the wire time
+     */
+    virtual unsigned int SpeedHz() const = 0;
+};
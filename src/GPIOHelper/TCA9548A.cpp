@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   TCA9548A.cpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#ifndef ELPP_DEFAULT_LOGGER
+#define ELPP_DEFAULT_LOGGER "TCA9548A"
+#endif
+#ifndef ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID
+#define ELPP_CURR_FILE_PERFORMANCE_LOGGER_ID ELPP_DEFAULT_LOGGER
+#endif
+
+#include "TCA9548A.hpp"
+#include "../common/easylogging/easylogging++.h"
+#include "../common/exception/ConfigErrorException.hpp"
+#include "../common/exception/NullPointerException.hpp"
+#include "I2CBus.hpp"
+
+TCA9548A::TCA9548A(I2CBus* bus, const unsigned char muxAddr)
+{
+    el::Loggers::getLogger(ELPP_DEFAULT_LOGGER);
+    if(bus == nullptr) {
+        throw NullPointerException("bus");
+    }
+    if(muxAddr < 0x70 || muxAddr > 0x77) {
+        throw ConfigErrorException("TCA9548A address must be 0x70 - 0x77");
+    }
+    _bus = bus;
+    _muxAddr = muxAddr;
+}
+
+TCA9548A::~TCA9548A()
+{
+}
+
+I2CBus* TCA9548A::GetBus() const
+{
+    return _bus;
+}
+
+unsigned char TCA9548A::GetAddress() const
+{
+    return _muxAddr;
+}
+
+I2CRoute TCA9548A::GetRoute(const unsigned char channel) const
+{
+    if(channel > 7) {
+        throw ConfigErrorException("TCA9548A channel must be 0 - 7");
+    }
+    I2CRoute route;
+    route.muxAddr = _muxAddr;
+    route.channel = channel;
+    return route;
+}
+
+int TCA9548A::DisableAll() const
+{
+    const auto result = _bus->SetMuxChannels(_muxAddr, 0x00);
+    if(result < 0) {
+        LOG(ERROR) << "disable channels failed";
+    }
+    return result;
+}
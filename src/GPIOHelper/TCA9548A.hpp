@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2026 punky
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * File:   TCA9548A.hpp
+ * Author: punky
+ *
+ * Created on 19. Oktober 2026
+ */
+
+#pragma once
+#include "I2CRequest.hpp"
+
+class I2CBus;
+
+/**
+ * \ingroup SystemFunctions
+ *
+ * TCA9548A 8 channel I²C multiplexer, devices behind it are created with
+ * the mux and their channel, the bus selects the channel on access
+ */
+class TCA9548A
+{
+    I2CBus* _bus;
+    unsigned char _muxAddr;
+
+  public:
+    /**
+     * Create new TCA9548A
+     * @param bus
+     *    the bus see I2CBus
+     * @param muxAddr
+     *    The mux Address 0x70 - 0x77
+     */
+    TCA9548A(I2CBus* bus, unsigned char muxAddr);
+    TCA9548A(const TCA9548A& orig) = delete;
+    TCA9548A(TCA9548A&& other) = delete;
+    TCA9548A& operator=(const TCA9548A& other) = delete;
+    TCA9548A& operator=(TCA9548A&& other) = delete;
+    virtual ~TCA9548A();
+
+    I2CBus* GetBus() const;
+    unsigned char GetAddress() const;
+    /**
+     * @param channel
+     *    0 - 7
+     */
+    I2CRoute GetRoute(unsigned char channel) const;
+    /**
+     * Switch all channels off, sample before a device on the main bus with a
+     * address used behind the mux
+     */
+    int DisableAll() const;
+};
@@ -0,0 +1,56 @@
+#pragma once
+#include <atomic>
+
+/**
+ * Intrusive lock free multi producer single consumer queue (D. Vyukov)
+ * T needs a member std::atomic<T*> next and a default constructor (stub node).
+ * Push is wait free from any thread, Pop only from the one consumer thread.
+ * Pop can return nullptr while a producer is in the middle of Push.
+ */
+template <typename T>
+class MpscQueue {
+	std::atomic<T*> _head;
+	T* _tail;
+	T _stub;
+
+public:
+	MpscQueue() : _head(&_stub), _tail(&_stub)
+	{
+		_stub.next.store(nullptr, std::memory_order_relaxed);
+	}
+	MpscQueue(const MpscQueue& orig) = delete;
+	MpscQueue& operator=(const MpscQueue& other) = delete;
+
+	void Push(T* node)
+	{
+		node->next.store(nullptr, std::memory_order_relaxed);
+		T* prev = _head.exchange(node, std::memory_order_acq_rel);
+		prev->next.store(node, std::memory_order_release);
+	}
+
+	T* Pop()
+	{
+		T* tail = _tail;
+		T* next = tail->next.load(std::memory_order_acquire);
+		if (tail == &_stub) {
+			if (next == nullptr)
+				return nullptr;
+			_tail = next;
+			tail = next;
+			next = next->next.load(std::memory_order_acquire);
+		}
+		if (next != nullptr) {
+			_tail = next;
+			return tail;
+		}
+		if (tail != _head.load(std::memory_order_acquire))
+			return nullptr;
+		Push(&_stub);
+		next = tail->next.load(std::memory_order_acquire);
+		if (next != nullptr) {
+			_tail = next;
+			return tail;
+		}
+		return nullptr;
+	}
+};